@@ -0,0 +1,48 @@
+#ifndef BASE_ALIGNMENT_H
+#define BASE_ALIGNMENT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Size of the cache line on all supported targets
+constexpr size_t CACHE_LINE_SIZE = 64U;
+
+constexpr bool IsPowerOfTwo(size_t value)
+{
+    return value != 0U && (value & (value - 1U)) == 0U;
+}
+
+// @param align should be a power of two
+constexpr size_t AlignUp(size_t value, size_t align)
+{
+    return (value + align - 1U) & ~(align - 1U);
+}
+
+// @param align should be a power of two
+constexpr size_t AlignDown(size_t value, size_t align)
+{
+    return value & ~(align - 1U);
+}
+
+constexpr bool IsAligned(size_t value, size_t align)
+{
+    return (value & (align - 1U)) == 0U;
+}
+
+// @returns the biggest power of two which divides @param value
+constexpr size_t LowestPowerOfTwoDivisor(size_t value)
+{
+    return value & (~value + 1U);
+}
+
+// @returns the smallest power of two which is not less than @param value
+constexpr size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1U;
+    while (result < value) {
+        result <<= 1U;
+    }
+    return result;
+}
+
+#endif  // BASE_ALIGNMENT_H
@@ -116,4 +116,11 @@
 #define LIKELY(exp) (__builtin_expect((exp) != 0, true))     // NOLINT(cppcoreguidelines-macro-usage)
 #define UNLIKELY(exp) (__builtin_expect((exp) != 0, false))  // NOLINT(cppcoreguidelines-macro-usage)
 
+// Code which is compiled only if allocator statistics are enabled by ALLOCATOR_STATS
+#ifdef ALLOCATOR_STATS
+#define STATS_ONLY(...) __VA_ARGS__  // NOLINT(cppcoreguidelines-macro-usage)
+#else
+#define STATS_ONLY(...)  // NOLINT(cppcoreguidelines-macro-usage)
+#endif
+
 #endif  // BASE_MACROS_H
@@ -0,0 +1,54 @@
+include(FetchContent)
+
+# Installed Google Benchmark is used if there is one
+find_package(benchmark QUIET)
+if(NOT benchmark_FOUND)
+  FetchContent_Declare(
+    googlebenchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG        v1.8.5
+  )
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  FetchContent_MakeAvailable(googlebenchmark)
+endif()
+
+# Use this target to build all benchmarks you added
+add_custom_target(
+  build_all_benchmarks
+)
+
+# Use this target to build and run all benchmarks you added
+add_custom_target(
+  run_all_benchmarks
+)
+
+function(add_benchmark)
+  set(one_value_args NAME)
+  set(multi_value_args SOURCES LIBS)
+  cmake_parse_arguments(BENCH "" "${one_value_args}" "${multi_value_args}" ${ARGN})
+
+  message("-- Added benchmark: ${BENCH_NAME}")
+
+  add_executable(${BENCH_NAME} ${BENCH_SOURCES})
+  target_link_libraries(${BENCH_NAME} PRIVATE benchmark::benchmark_main ${BENCH_LIBS})
+  # numbers of unoptimized code mean nothing, whatever the build type is
+  target_compile_options(${BENCH_NAME} PRIVATE -O2)
+
+  add_custom_target(
+    ${BENCH_NAME}_run
+    COMMAND ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/${BENCH_NAME}
+    DEPENDS ${BENCH_NAME}
+  )
+
+  add_dependencies(
+    build_all_benchmarks
+    ${BENCH_NAME}
+  )
+
+  add_dependencies(
+    run_all_benchmarks
+    ${BENCH_NAME}_run
+  )
+
+endfunction()
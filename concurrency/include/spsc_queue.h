@@ -0,0 +1,67 @@
+#ifndef CONCURRENCY_INCLUDE_SPSC_QUEUE_H
+#define CONCURRENCY_INCLUDE_SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include "base/alignment.h"
+#include "base/macros.h"
+
+/**
+ * @brief Bounded lock-free queue of CAPACITY values for one producer and one consumer thread.
+ * T should be default constructible and movable, popped slots keep moved-from values till they are pushed again
+ */
+template <class T, size_t CAPACITY>
+class SpscQueue {
+    static_assert(IsPowerOfTwo(CAPACITY), "capacity should be a power of two");
+
+    static constexpr size_t MASK = CAPACITY - 1U;
+
+public:
+    SpscQueue() = default;
+    ~SpscQueue() = default;
+    NO_COPY_SEMANTIC(SpscQueue);
+    NO_MOVE_SEMANTIC(SpscQueue);
+
+    // @returns false if the queue is full, then @param value is not moved
+    bool TryPush(T &value)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == CAPACITY) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == CAPACITY) {
+                return false;
+            }
+        }
+        slots_[tail & MASK] = std::move(value);
+        tail_.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    // @returns false if the queue is empty
+    bool TryPop(T &value)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & MASK]);
+        head_.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, CAPACITY> slots_ {};
+    // the consumer side: the next slot to pop and the last tail it saw
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_ {0U};
+    size_t cachedTail_ = 0U;
+    // the producer side: the next slot to push and the last head it saw
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_ {0U};
+    size_t cachedHead_ = 0U;
+};
+
+#endif  // CONCURRENCY_INCLUDE_SPSC_QUEUE_H
@@ -0,0 +1,85 @@
+#ifndef CONCURRENCY_INCLUDE_THREAD_HARNESS_H
+#define CONCURRENCY_INCLUDE_THREAD_HARNESS_H
+
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "base/macros.h"
+
+/**
+ * @brief Barrier for a fixed count of threads which can be passed many times. Waiting threads spin with yields, so
+ * they do not sleep in the kernel, and it still works when there are more threads than CPUs
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(size_t count) : count_(count), waiting_(count) {}
+    ~SpinBarrier() = default;
+    NO_COPY_SEMANTIC(SpinBarrier);
+    NO_MOVE_SEMANTIC(SpinBarrier);
+
+    void Wait()
+    {
+        size_t phase = phase_.load(std::memory_order_relaxed);
+        if (waiting_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+            waiting_.store(count_, std::memory_order_relaxed);
+            phase_.store(phase + 1U, std::memory_order_release);
+            return;
+        }
+        while (phase_.load(std::memory_order_acquire) == phase) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    const size_t count_;
+    std::atomic<size_t> waiting_;
+    std::atomic<size_t> phase_ {0U};
+};
+
+// time of one RunThreads() call
+struct RunTime {
+    double wallSeconds = 0.0;
+    // CPU time of the whole process, so it includes threads which are not a part of the run
+    double cpuSeconds = 0.0;
+};
+
+inline double ProcessCpuSeconds()
+{
+    constexpr double NANOSECONDS_IN_SECOND = 1e9;
+    timespec time {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / NANOSECONDS_IN_SECOND;
+}
+
+/**
+ * @brief Runs @param body(threadIdx) in @param threadsCount threads started at once.
+ * Only the time between the start and the end of the last thread is measured, thread creation is not
+ */
+template <class Body>
+RunTime RunThreads(size_t threadsCount, Body body)
+{
+    SpinBarrier start(threadsCount + 1U);
+    std::vector<std::thread> threads;
+    threads.reserve(threadsCount);
+    for (size_t i = 0U; i < threadsCount; ++i) {
+        threads.emplace_back([&start, &body, i] {
+            start.Wait();
+            body(i);
+        });
+    }
+    double cpuStart = ProcessCpuSeconds();
+    auto wallStart = std::chrono::steady_clock::now();
+    start.Wait();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    RunTime time;
+    time.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    time.cpuSeconds = ProcessCpuSeconds() - cpuStart;
+    return time;
+}
+
+#endif  // CONCURRENCY_INCLUDE_THREAD_HARNESS_H
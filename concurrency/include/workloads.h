@@ -0,0 +1,378 @@
+#ifndef CONCURRENCY_INCLUDE_WORKLOADS_H
+#define CONCURRENCY_INCLUDE_WORKLOADS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "base/macros.h"
+#include "concurrency/include/spsc_queue.h"
+#include "concurrency/include/thread_harness.h"
+#include "memory_management/free_list_allocator/include/concurrent_free_list_allocator.h"
+#include "memory_management/reference_counting_gc/include/object_module.h"
+#include "memory_management/reference_counting_gc/include/ref_count.h"
+#include "memory_management/run_of_slots_allocator/include/thread_cached_run_of_slots_allocator.h"
+
+/**
+ * Multi-threaded workloads for concurrent allocators and Object. Every workload runs a fixed count of operations per
+ * thread, so the ideal throughput grows linearly with threads. Blocks are stamped by the thread which allocates them
+ * and checked by the thread which frees them, so memory given to two threads at once is counted as an error.
+ *
+ * Allocators are used through fronts: a front holds the shared allocator and its Local, created by every thread,
+ * has Block *Allocate() and void Free(Block *) for blocks allocated by any thread.
+ */
+
+constexpr size_t BLOCK_SIZE = 64U;
+// blocks allocated before they are freed or handed over
+constexpr size_t WORKLOAD_BATCH_SIZE = 256U;
+// blocks or objects a producer may get ahead of its consumer
+constexpr size_t QUEUE_CAPACITY = 1024U;
+
+struct Block {
+    std::array<uint64_t, BLOCK_SIZE / sizeof(uint64_t)> words;
+};
+
+struct WorkloadResult {
+    RunTime time;
+    // allocations and frees, or reference count updates
+    size_t operations = 0U;
+    // failed allocations, blocks overwritten by another thread and objects which were not destroyed once
+    size_t errors = 0U;
+};
+
+class MallocFront {
+public:
+    static constexpr const char *NAME = "malloc";
+
+    class Local {
+    public:
+        explicit Local([[maybe_unused]] MallocFront &front) {}
+
+        Block *Allocate()
+        {
+            return static_cast<Block *>(std::malloc(sizeof(Block)));  // NOLINT(cppcoreguidelines-no-malloc)
+        }
+
+        void Free(Block *block)
+        {
+            std::free(block);  // NOLINT(cppcoreguidelines-no-malloc)
+        }
+    };
+};
+
+// pools are small, so threads grow and share them
+template <size_t ONE_MEM_POOL_SIZE = 1U << 20U, size_t SHARDS_COUNT = 16U>
+class ConcurrentFreeListFront {
+public:
+    static constexpr const char *NAME = "concurrent_free_list";
+
+    class Local {
+    public:
+        explicit Local(ConcurrentFreeListFront &front) : allocator_(front.allocator_) {}
+
+        Block *Allocate()
+        {
+            return allocator_.template Allocate<Block>(1U);
+        }
+
+        void Free(Block *block)
+        {
+            allocator_.Free(block);
+        }
+
+    private:
+        ConcurrentFreeListAllocator<ONE_MEM_POOL_SIZE, SHARDS_COUNT> &allocator_;
+    };
+
+private:
+    ConcurrentFreeListAllocator<ONE_MEM_POOL_SIZE, SHARDS_COUNT> allocator_;
+};
+
+// the pool of the only size class never grows, so it holds blocks of all threads and queues
+template <size_t ONE_MEM_POOL_SIZE = 64U << 20U>
+class ThreadCachedRunOfSlotsFront {
+    using Allocator = ThreadCachedRunOfSlotsAllocator<ONE_MEM_POOL_SIZE, BLOCK_SIZE>;
+
+public:
+    static constexpr const char *NAME = "thread_cached_run_of_slots";
+
+    class Local {
+    public:
+        explicit Local(ThreadCachedRunOfSlotsFront &front) : cache_(front.allocator_) {}
+
+        Block *Allocate()
+        {
+            return cache_.template Allocate<Block>();
+        }
+
+        void Free(Block *block)
+        {
+            cache_.Free(block);
+        }
+
+    private:
+        typename Allocator::ThreadCache cache_;
+    };
+
+private:
+    Allocator allocator_;
+};
+
+inline uint64_t Stamp(size_t thread, size_t seq)
+{
+    constexpr size_t THREAD_SHIFT = 40U;
+    return (static_cast<uint64_t>(thread) << THREAD_SHIFT) | seq;
+}
+
+inline void Fill(Block *block, uint64_t stamp)
+{
+    block->words.fill(stamp);
+}
+
+// @returns true if @param block still holds @param stamp in every word
+inline bool Check(const Block *block, uint64_t stamp)
+{
+    for (uint64_t word : block->words) {
+        if (word != stamp) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Every thread allocates batches of blocks and frees them by itself, the latest first.
+ * It shows the scaling of the allocator when threads share nothing but the allocator
+ */
+template <class Front>
+WorkloadResult RunLocalWorkload(Front &front, size_t threadsCount, size_t blocksPerThread)
+{
+    std::atomic<size_t> errors {0U};
+    size_t rounds = blocksPerThread / WORKLOAD_BATCH_SIZE;
+    WorkloadResult result;
+    result.time = RunThreads(threadsCount, [&front, &errors, rounds](size_t thread) {
+        typename Front::Local local(front);
+        std::array<Block *, WORKLOAD_BATCH_SIZE> blocks {};
+        size_t localErrors = 0U;
+        for (size_t round = 0U; round < rounds; ++round) {
+            for (size_t i = 0U; i < WORKLOAD_BATCH_SIZE; ++i) {
+                blocks[i] = local.Allocate();
+                if (blocks[i] != nullptr) {
+                    Fill(blocks[i], Stamp(thread, i));
+                }
+            }
+            for (size_t i = WORKLOAD_BATCH_SIZE; i-- > 0U;) {
+                localErrors += blocks[i] == nullptr || !Check(blocks[i], Stamp(thread, i)) ? 1U : 0U;
+                local.Free(blocks[i]);
+            }
+        }
+        errors.fetch_add(localErrors, std::memory_order_relaxed);
+    });
+    result.operations = 2U * threadsCount * rounds * WORKLOAD_BATCH_SIZE;
+    result.errors = errors.load(std::memory_order_relaxed);
+    return result;
+}
+
+// the count of threads workloads with pairs of threads use instead of @param threadsCount
+inline size_t PairedThreadsCount(size_t threadsCount)
+{
+    return threadsCount < 2U ? 2U : threadsCount & ~size_t {1U};
+}
+
+/**
+ * @brief Threads are split into pairs: the producer allocates blocks and passes them through a queue to the consumer
+ * which frees them, so every free is a free of memory of another thread.
+ * @param threadsCount is rounded down to an even count, but it is at least 2
+ */
+template <class Front>
+WorkloadResult RunProducerConsumerWorkload(Front &front, size_t threadsCount, size_t blocksPerThread)
+{
+    using Queue = SpscQueue<Block *, QUEUE_CAPACITY>;
+    threadsCount = PairedThreadsCount(threadsCount);
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (size_t i = 0U; i < threadsCount / 2U; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    std::atomic<size_t> errors {0U};
+    WorkloadResult result;
+    result.time = RunThreads(threadsCount, [&front, &queues, &errors, blocksPerThread](size_t thread) {
+        typename Front::Local local(front);
+        Queue &queue = *queues[thread / 2U];
+        size_t pair = thread / 2U;
+        size_t localErrors = 0U;
+        if (thread % 2U == 0U) {
+            for (size_t seq = 0U; seq < blocksPerThread; ++seq) {
+                Block *block = local.Allocate();
+                if (block != nullptr) {
+                    Fill(block, Stamp(pair, seq));
+                } else {
+                    ++localErrors;
+                }
+                while (!queue.TryPush(block)) {
+                    std::this_thread::yield();
+                }
+            }
+        } else {
+            for (size_t seq = 0U; seq < blocksPerThread; ++seq) {
+                Block *block = nullptr;
+                while (!queue.TryPop(block)) {
+                    std::this_thread::yield();
+                }
+                if (block != nullptr) {
+                    localErrors += Check(block, Stamp(pair, seq)) ? 0U : 1U;
+                    local.Free(block);
+                }
+            }
+        }
+        errors.fetch_add(localErrors, std::memory_order_relaxed);
+    });
+    result.operations = threadsCount * blocksPerThread;
+    result.errors = errors.load(std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief In every round each thread allocates a batch of blocks and then frees the batch of the next thread,
+ * so all threads free memory of others at the same time
+ */
+template <class Front>
+WorkloadResult RunCrossThreadFreeWorkload(Front &front, size_t threadsCount, size_t blocksPerThread)
+{
+    std::vector<std::array<Block *, WORKLOAD_BATCH_SIZE>> batches(threadsCount);
+    SpinBarrier barrier(threadsCount);
+    std::atomic<size_t> errors {0U};
+    size_t rounds = blocksPerThread / WORKLOAD_BATCH_SIZE;
+    WorkloadResult result;
+    result.time = RunThreads(threadsCount, [&, rounds](size_t thread) {
+        typename Front::Local local(front);
+        size_t next = (thread + 1U) % threadsCount;
+        size_t localErrors = 0U;
+        for (size_t round = 0U; round < rounds; ++round) {
+            for (size_t i = 0U; i < WORKLOAD_BATCH_SIZE; ++i) {
+                Block *block = local.Allocate();
+                if (block != nullptr) {
+                    Fill(block, Stamp(thread, i));
+                }
+                batches[thread][i] = block;
+            }
+            barrier.Wait();
+            for (size_t i = 0U; i < WORKLOAD_BATCH_SIZE; ++i) {
+                Block *block = batches[next][i];
+                localErrors += block == nullptr || !Check(block, Stamp(next, i)) ? 1U : 0U;
+                local.Free(block);
+            }
+            // the batch is refilled only after its blocks are freed
+            barrier.Wait();
+        }
+        errors.fetch_add(localErrors, std::memory_order_relaxed);
+    });
+    result.operations = 2U * threadsCount * rounds * WORKLOAD_BATCH_SIZE;
+    result.errors = errors.load(std::memory_order_relaxed);
+    return result;
+}
+
+// payload of objects which counts its destructions
+struct CountedPayload {
+    CountedPayload(size_t valueArg, std::atomic<size_t> *destroyedArg) : value(valueArg), destroyed(destroyedArg) {}
+    ~CountedPayload()
+    {
+        destroyed->fetch_add(1U, std::memory_order_relaxed);
+    }
+    NO_COPY_SEMANTIC(CountedPayload);
+    NO_MOVE_SEMANTIC(CountedPayload);
+
+    size_t value;
+    std::atomic<size_t> *destroyed;
+};
+
+/**
+ * @brief All threads copy and drop one object created by the calling thread, so they all update one count.
+ * It shows the cost of sharing one reference count cache line
+ */
+template <class RefCount>
+WorkloadResult RunSharedObjectWorkload(size_t threadsCount, size_t copiesPerThread)
+{
+    std::atomic<size_t> destroyed {0U};
+    WorkloadResult result;
+    {
+        auto shared = MakeObject<CountedPayload, RefCount>(0U, &destroyed);
+        std::atomic<size_t> errors {0U};
+        result.time = RunThreads(threadsCount, [&shared, &errors, copiesPerThread](size_t /* thread */) {
+            size_t localErrors = 0U;
+            for (size_t i = 0U; i < copiesPerThread; ++i) {
+                Object<CountedPayload, RefCount> copy = shared;  // NOLINT(performance-unnecessary-copy-initialization)
+                localErrors += copy->value == 0U ? 0U : 1U;
+            }
+            errors.fetch_add(localErrors, std::memory_order_relaxed);
+        });
+        result.errors = errors.load(std::memory_order_relaxed) + (shared.UseCount() == 1U ? 0U : 1U);
+    }
+    if constexpr (std::is_same_v<RefCount, BiasedRefCount>) {
+        BiasedRefCount::MergeQueued();
+    }
+    result.errors += destroyed.load(std::memory_order_relaxed) == 1U ? 0U : 1U;
+    // a copy takes and drops a reference
+    result.operations = 2U * threadsCount * copiesPerThread;
+    return result;
+}
+
+/**
+ * @brief Threads are split into pairs: the producer creates objects and moves them through a queue to the consumer
+ * which drops the last reference, so every object is destroyed by a thread which did not create it.
+ * @param threadsCount is rounded down to an even count, but it is at least 2
+ */
+template <class RefCount>
+WorkloadResult RunObjectHandoffWorkload(size_t threadsCount, size_t objectsPerThread)
+{
+    using Queue = SpscQueue<Object<CountedPayload, RefCount>, QUEUE_CAPACITY>;
+    threadsCount = PairedThreadsCount(threadsCount);
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (size_t i = 0U; i < threadsCount / 2U; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    std::atomic<size_t> destroyed {0U};
+    std::atomic<size_t> errors {0U};
+    WorkloadResult result;
+    result.time = RunThreads(threadsCount, [&queues, &destroyed, &errors, objectsPerThread](size_t thread) {
+        Queue &queue = *queues[thread / 2U];
+        size_t localErrors = 0U;
+        if (thread % 2U == 0U) {
+            for (size_t seq = 0U; seq < objectsPerThread; ++seq) {
+                auto obj = MakeObject<CountedPayload, RefCount>(seq, &destroyed);
+                while (!queue.TryPush(obj)) {
+                    std::this_thread::yield();
+                }
+                if constexpr (std::is_same_v<RefCount, BiasedRefCount>) {
+                    // the producer drops no references, so it merges counts of objects dropped by the consumer
+                    if (seq % QUEUE_CAPACITY == 0U) {
+                        BiasedRefCount::MergeQueued();
+                    }
+                }
+            }
+        } else {
+            for (size_t seq = 0U; seq < objectsPerThread; ++seq) {
+                Object<CountedPayload, RefCount> obj;
+                while (!queue.TryPop(obj)) {
+                    std::this_thread::yield();
+                }
+                localErrors += obj->value == seq ? 0U : 1U;
+            }
+        }
+        errors.fetch_add(localErrors, std::memory_order_relaxed);
+    });
+    // objects dropped after their producer finished are destroyed by the consumer or at the producer exit
+    queues.clear();
+    size_t expected = threadsCount / 2U * objectsPerThread;
+    result.errors =
+        errors.load(std::memory_order_relaxed) + (destroyed.load(std::memory_order_relaxed) == expected ? 0U : 1U);
+    // an operation is an object created, handed over and destroyed
+    result.operations = expected;
+    return result;
+}
+
+#endif  // CONCURRENCY_INCLUDE_WORKLOADS_H
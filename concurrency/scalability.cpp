@@ -0,0 +1,110 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "concurrency/include/workloads.h"
+#include "memory_management/reference_counting_gc/include/ref_count.h"
+
+/**
+ * Scaling curves of concurrent allocators and Object:
+ *   scalability [max threads] [operations per thread]
+ * Every workload runs with 1, 2, 4... threads up to max threads, which is the count of CPUs by default. Work per
+ * thread is fixed, so the ideal throughput grows linearly:
+ *   speedup - throughput divided by the throughput with the fewest threads
+ *   efficiency - speedup divided by its ideal value, it falls when threads contend for locks or cache lines
+ *   cpu - CPU time divided by wall time of all threads, it falls when threads sleep on locks or are not run
+ *         because there are more threads than CPUs
+ * The process exits with failure if any workload finds memory given to two threads or objects not destroyed once.
+ */
+
+namespace {
+constexpr size_t DEFAULT_OPERATIONS = 1U << 18U;
+
+std::vector<size_t> ThreadCounts(size_t maxThreads, size_t minThreads)
+{
+    std::vector<size_t> counts;
+    for (size_t threads = minThreads; threads < maxThreads; threads *= 2U) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads < minThreads ? minThreads : maxThreads);
+    return counts;
+}
+
+class Report {
+public:
+    // @param run(threads) returns WorkloadResult of the workload with threads
+    template <class Run>
+    void Curve(const char *workload, const char *subject, const std::vector<size_t> &threadCounts, Run run)
+    {
+        double baseThroughput = 0.0;
+        size_t baseThreads = 0U;
+        for (size_t threads : threadCounts) {
+            WorkloadResult result = run(threads);
+            double throughput = static_cast<double>(result.operations) / result.time.wallSeconds;
+            if (baseThreads == 0U) {
+                baseThroughput = throughput;
+                baseThreads = threads;
+            }
+            double speedup = throughput / baseThroughput;
+            double efficiency = speedup * static_cast<double>(baseThreads) / static_cast<double>(threads);
+            double cpu = result.time.cpuSeconds / (result.time.wallSeconds * static_cast<double>(threads));
+            std::printf("%-18s %-28s %7zu %14.0f %8.2f %10.2f %6.2f %7zu\n", workload, subject, threads, throughput,
+                        speedup, efficiency, cpu, result.errors);
+            std::fflush(stdout);
+            errors_ += result.errors;
+        }
+    }
+
+    size_t GetErrors() const
+    {
+        return errors_;
+    }
+
+private:
+    size_t errors_ = 0U;
+};
+
+template <class Front>
+void AllocatorCurves(Report &report, size_t maxThreads, size_t operations)
+{
+    // pools are kept between runs, so later runs do not pay for growing them
+    auto front = std::make_unique<Front>();
+    report.Curve("local", Front::NAME, ThreadCounts(maxThreads, 1U),
+                 [&](size_t threads) { return RunLocalWorkload(*front, threads, operations); });
+    report.Curve("cross_thread_free", Front::NAME, ThreadCounts(maxThreads, 1U),
+                 [&](size_t threads) { return RunCrossThreadFreeWorkload(*front, threads, operations); });
+    report.Curve("producer_consumer", Front::NAME, ThreadCounts(maxThreads, 2U),
+                 [&](size_t threads) { return RunProducerConsumerWorkload(*front, threads, operations); });
+}
+
+template <class RefCount>
+void ObjectCurves(Report &report, const char *name, size_t maxThreads, size_t operations)
+{
+    report.Curve("shared_object", name, ThreadCounts(maxThreads, 1U),
+                 [&](size_t threads) { return RunSharedObjectWorkload<RefCount>(threads, operations); });
+    report.Curve("object_handoff", name, ThreadCounts(maxThreads, 2U),
+                 [&](size_t threads) { return RunObjectHandoffWorkload<RefCount>(threads, operations); });
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    size_t maxThreads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : DEFAULT_OPERATIONS;
+    if (maxThreads == 0U || operations < WORKLOAD_BATCH_SIZE) {
+        std::fprintf(stderr, "usage: %s [max threads] [operations per thread, at least %zu]\n", argv[0],
+                     WORKLOAD_BATCH_SIZE);
+        return EXIT_FAILURE;
+    }
+    std::printf("%-18s %-28s %7s %14s %8s %10s %6s %7s\n", "workload", "subject", "threads", "ops_per_sec", "speedup",
+                "efficiency", "cpu", "errors");
+    Report report;
+    AllocatorCurves<MallocFront>(report, maxThreads, operations);
+    AllocatorCurves<ConcurrentFreeListFront<>>(report, maxThreads, operations);
+    AllocatorCurves<ThreadCachedRunOfSlotsFront<>>(report, maxThreads, operations);
+    ObjectCurves<AtomicRefCount>(report, "atomic_ref_count", maxThreads, operations);
+    ObjectCurves<BiasedRefCount>(report, "biased_ref_count", maxThreads, operations);
+    return report.GetErrors() == 0U ? EXIT_SUCCESS : EXIT_FAILURE;
+}
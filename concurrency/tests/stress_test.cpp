@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "concurrency/include/spsc_queue.h"
+#include "concurrency/include/thread_harness.h"
+#include "concurrency/include/workloads.h"
+#include "memory_management/reference_counting_gc/include/ref_count.h"
+
+namespace {
+// more threads than CPUs make threads be preempted in the middle of operations
+constexpr size_t THREADS_COUNT = 8U;
+constexpr size_t BLOCKS_PER_THREAD = 4U * WORKLOAD_BATCH_SIZE;
+constexpr size_t OBJECTS_PER_THREAD = 4U * QUEUE_CAPACITY;
+
+template <class Front>
+void CheckAllocatorWorkloads()
+{
+    auto front = std::make_unique<Front>();
+    for (size_t threads : {size_t {1U}, THREADS_COUNT}) {
+        WorkloadResult local = RunLocalWorkload(*front, threads, BLOCKS_PER_THREAD);
+        ASSERT_EQ(local.errors, 0U);
+        ASSERT_EQ(local.operations, 2U * threads * BLOCKS_PER_THREAD);
+        WorkloadResult crossFree = RunCrossThreadFreeWorkload(*front, threads, BLOCKS_PER_THREAD);
+        ASSERT_EQ(crossFree.errors, 0U);
+        ASSERT_EQ(crossFree.operations, 2U * threads * BLOCKS_PER_THREAD);
+        WorkloadResult producerConsumer = RunProducerConsumerWorkload(*front, threads, BLOCKS_PER_THREAD);
+        ASSERT_EQ(producerConsumer.errors, 0U);
+        ASSERT_EQ(producerConsumer.operations, PairedThreadsCount(threads) * BLOCKS_PER_THREAD);
+    }
+}
+
+template <class RefCount>
+void CheckObjectWorkloads()
+{
+    WorkloadResult shared = RunSharedObjectWorkload<RefCount>(THREADS_COUNT, OBJECTS_PER_THREAD);
+    ASSERT_EQ(shared.errors, 0U);
+    WorkloadResult handoff = RunObjectHandoffWorkload<RefCount>(THREADS_COUNT, OBJECTS_PER_THREAD);
+    ASSERT_EQ(handoff.errors, 0U);
+    ASSERT_EQ(handoff.operations, THREADS_COUNT / 2U * OBJECTS_PER_THREAD);
+}
+}  // namespace
+
+TEST(SpscQueueTest, OrderTest)
+{
+    constexpr size_t CAPACITY = 4U;
+    SpscQueue<size_t, CAPACITY> queue;
+    size_t value = 0U;
+    ASSERT_FALSE(queue.TryPop(value));
+    for (size_t i = 0U; i < CAPACITY; ++i) {
+        value = i;
+        ASSERT_TRUE(queue.TryPush(value));
+    }
+    value = CAPACITY;
+    ASSERT_FALSE(queue.TryPush(value));
+    for (size_t i = 0U; i < CAPACITY; ++i) {
+        ASSERT_TRUE(queue.TryPop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscQueueTest, ThreadsTest)
+{
+    constexpr size_t VALUES_COUNT = 100000U;
+    auto queue = std::make_unique<SpscQueue<size_t, 64U>>();
+    std::thread producer([&queue] {
+        for (size_t i = 0U; i < VALUES_COUNT; ++i) {
+            size_t value = i;
+            while (!queue->TryPush(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (size_t i = 0U; i < VALUES_COUNT; ++i) {
+        size_t value = 0U;
+        while (!queue->TryPop(value)) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(value, i);
+    }
+    producer.join();
+}
+
+TEST(SpinBarrierTest, PhasesTest)
+{
+    constexpr size_t PHASES_COUNT = 100U;
+    SpinBarrier barrier(THREADS_COUNT);
+    std::vector<std::atomic<size_t>> arrived(PHASES_COUNT);
+    std::atomic<size_t> errors {0U};
+    RunThreads(THREADS_COUNT, [&](size_t /* thread */) {
+        for (size_t phase = 0U; phase < PHASES_COUNT; ++phase) {
+            arrived[phase].fetch_add(1U);
+            barrier.Wait();
+            // nobody passes the barrier before everyone arrives
+            errors.fetch_add(arrived[phase].load() == THREADS_COUNT ? 0U : 1U);
+        }
+    });
+    ASSERT_EQ(errors.load(), 0U);
+}
+
+TEST(StressTest, MallocTest)
+{
+    CheckAllocatorWorkloads<MallocFront>();
+}
+
+TEST(StressTest, ConcurrentFreeListTest)
+{
+    CheckAllocatorWorkloads<ConcurrentFreeListFront<>>();
+    // few shards make threads share them
+    CheckAllocatorWorkloads<ConcurrentFreeListFront<1U << 16U, 2U>>();
+}
+
+TEST(StressTest, ThreadCachedRunOfSlotsTest)
+{
+    CheckAllocatorWorkloads<ThreadCachedRunOfSlotsFront<>>();
+}
+
+TEST(StressTest, AtomicObjectTest)
+{
+    CheckObjectWorkloads<AtomicRefCount>();
+}
+
+TEST(StressTest, BiasedObjectTest)
+{
+    CheckObjectWorkloads<BiasedRefCount>();
+}
@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "memory_management/benchmarks/include/allocator_adapters.h"
+
+namespace {
+// allocations made before they are freed
+constexpr size_t BATCH_SIZE = 1024U;
+constexpr size_t MIN_SIZE = 16U;
+constexpr size_t MAX_SIZE = 1024U;
+constexpr int SIZE_MULTIPLIER = 4;
+constexpr uint64_t SEED = 42U;
+constexpr double P50 = 0.5;
+constexpr double P99 = 0.99;
+constexpr double P999 = 0.999;
+
+// order in which a batch is freed
+enum class Pattern {
+    // the latest allocation first, like a stack
+    LIFO,
+    // the earliest allocation first, like a queue
+    FIFO,
+    RANDOM,
+};
+
+std::vector<size_t> FreeOrder(Pattern pattern)
+{
+    std::vector<size_t> order(BATCH_SIZE);
+    std::iota(order.begin(), order.end(), 0U);
+    if (pattern == Pattern::LIFO) {
+        std::reverse(order.begin(), order.end());
+    } else if (pattern == Pattern::RANDOM) {
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(SEED));
+    }
+    return order;
+}
+
+// throughput of allocations of state.range(0) bytes, every allocation is freed in the order of PATTERN
+template <class Adapter, Pattern PATTERN>
+void BM_AllocateFree(benchmark::State &state)
+{
+    auto size = static_cast<size_t>(state.range(0));
+    auto adapter = std::make_unique<Adapter>();
+    std::vector<void *> ptrs(BATCH_SIZE);
+    const std::vector<size_t> order = FreeOrder(PATTERN);
+    bool failed = false;
+    for (auto _ : state) {
+        for (void *&ptr : ptrs) {
+            ptr = adapter->Allocate(size);
+            failed |= ptr == nullptr;
+        }
+        benchmark::DoNotOptimize(ptrs.data());
+        for (size_t idx : order) {
+            adapter->Free(ptrs[idx]);
+        }
+        adapter->Reset();
+        benchmark::ClobberMemory();
+    }
+    if (failed) {
+        state.SkipWithError("allocator is out of memory");
+        return;
+    }
+    // one item is an allocation with its free
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+}
+
+// @returns nanoseconds of @param percentile of sorted @param samples
+double Percentile(const std::vector<int64_t> &samples, double percentile)
+{
+    auto idx = static_cast<size_t>(percentile * static_cast<double>(samples.size() - 1U));
+    return static_cast<double>(samples[idx]);
+}
+
+void ReportPercentiles(benchmark::State &state, const char *name, std::vector<int64_t> &samples)
+{
+    std::sort(samples.begin(), samples.end());
+    state.counters[std::string(name) + "_p50_ns"] = Percentile(samples, P50);
+    state.counters[std::string(name) + "_p99_ns"] = Percentile(samples, P99);
+    state.counters[std::string(name) + "_p999_ns"] = Percentile(samples, P999);
+}
+
+/**
+ * @brief Latency percentiles of single allocations and frees of state.range(0) bytes, a batch is freed in random
+ * order. Every call is timed by steady_clock, the clock_p50_ns counter shows its own cost included in the samples
+ */
+template <class Adapter>
+void BM_AllocateFreeLatency(benchmark::State &state)
+{
+    using Clock = std::chrono::steady_clock;
+    // memory for samples is bounded, later iterations are not sampled
+    constexpr size_t MAX_SAMPLES = 1U << 20U;
+    auto size = static_cast<size_t>(state.range(0));
+    auto adapter = std::make_unique<Adapter>();
+    std::vector<void *> ptrs(BATCH_SIZE);
+    const std::vector<size_t> order = FreeOrder(Pattern::RANDOM);
+    std::vector<int64_t> allocateSamples;
+    std::vector<int64_t> freeSamples;
+    allocateSamples.reserve(MAX_SAMPLES);
+    freeSamples.reserve(MAX_SAMPLES);
+    bool failed = false;
+    for (auto _ : state) {
+        bool sampled = allocateSamples.size() + BATCH_SIZE <= MAX_SAMPLES;
+        for (void *&ptr : ptrs) {
+            auto start = Clock::now();
+            ptr = adapter->Allocate(size);
+            auto end = Clock::now();
+            failed |= ptr == nullptr;
+            if (sampled) {
+                allocateSamples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
+        }
+        for (size_t idx : order) {
+            auto start = Clock::now();
+            adapter->Free(ptrs[idx]);
+            auto end = Clock::now();
+            if (sampled) {
+                freeSamples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
+        }
+        adapter->Reset();
+    }
+    if (failed) {
+        state.SkipWithError("allocator is out of memory");
+        return;
+    }
+    std::vector<int64_t> clockSamples(BATCH_SIZE);
+    for (int64_t &sample : clockSamples) {
+        auto start = Clock::now();
+        auto end = Clock::now();
+        sample = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+    ReportPercentiles(state, "allocate", allocateSamples);
+    ReportPercentiles(state, "free", freeSamples);
+    std::sort(clockSamples.begin(), clockSamples.end());
+    state.counters["clock_p50_ns"] = Percentile(clockSamples, P50);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+}
+
+void Sizes(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->RangeMultiplier(SIZE_MULTIPLIER)->Range(MIN_SIZE, MAX_SIZE);
+}
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define ALLOCATOR_BENCHMARKS(Adapter)                                                  \
+    BENCHMARK_TEMPLATE(BM_AllocateFree, Adapter, Pattern::LIFO)->Apply(Sizes);   \
+    BENCHMARK_TEMPLATE(BM_AllocateFree, Adapter, Pattern::FIFO)->Apply(Sizes);   \
+    BENCHMARK_TEMPLATE(BM_AllocateFree, Adapter, Pattern::RANDOM)->Apply(Sizes); \
+    BENCHMARK_TEMPLATE(BM_AllocateFreeLatency, Adapter)->Apply(Sizes)
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+ALLOCATOR_BENCHMARKS(MallocAdapter);
+ALLOCATOR_BENCHMARKS(BumpPointerAdapter);
+ALLOCATOR_BENCHMARKS(RunOfSlotsAdapter);
+ALLOCATOR_BENCHMARKS(FreeListAdapter);
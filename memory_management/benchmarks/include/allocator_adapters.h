@@ -0,0 +1,90 @@
+#ifndef MEMORY_MANAGEMENT_BENCHMARKS_INCLUDE_ALLOCATOR_ADAPTERS_H
+#define MEMORY_MANAGEMENT_BENCHMARKS_INCLUDE_ALLOCATOR_ADAPTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include "base/alignment.h"
+#include "base/macros.h"
+#include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+#include "memory_management/common/include/allocator_traits.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
+
+/**
+ * Allocators behind one interface with the size known at runtime, so workloads can be run against each of them:
+ *   void *Allocate(size_t size, size_t align = ADAPTER_ALIGN) - memory aligned like malloc() or to align, nullptr
+ *   if the allocator is out of memory
+ *   void Free(void *ptr)
+ *   void Reset() - gives back memory of allocators which do not free it one by one
+ * Adapters of the project allocators keep pools inside, so they should be created on the heap.
+ */
+
+// alignment malloc() gives
+constexpr size_t ADAPTER_ALIGN = alignof(std::max_align_t);
+
+class MallocAdapter {
+public:
+    void *Allocate(size_t size, size_t align = ADAPTER_ALIGN)
+    {
+        if (align <= ADAPTER_ALIGN) {
+            return std::malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+        }
+        // aligned_alloc() wants a size which is a multiple of the alignment
+        return std::aligned_alloc(align, AlignUp(size, align));
+    }
+
+    void Free(void *ptr)
+    {
+        std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
+    void Reset() {}
+};
+
+template <class Allocator>
+class AllocatorAdapter {
+public:
+    AllocatorAdapter() = default;
+    ~AllocatorAdapter() = default;
+    NO_COPY_SEMANTIC(AllocatorAdapter);
+    NO_MOVE_SEMANTIC(AllocatorAdapter);
+
+    void *Allocate(size_t size, size_t align = ADAPTER_ALIGN)
+    {
+        return allocator_.template AllocateAligned<uint8_t>(size, align < ADAPTER_ALIGN ? ADAPTER_ALIGN : align);
+    }
+
+    void Free([[maybe_unused]] void *ptr)
+    {
+        if constexpr (CAN_FREE_ONE<Allocator>) {
+            allocator_.Free(ptr);
+        }
+    }
+
+    void Reset()
+    {
+        if constexpr (!CAN_FREE_ONE<Allocator>) {
+            allocator_.Free();
+        }
+    }
+
+    Allocator &GetAllocator()
+    {
+        return allocator_;
+    }
+
+private:
+    Allocator allocator_;
+};
+
+// pool of every size class holds 1 KiB allocations of a whole batch
+constexpr size_t ADAPTER_POOL_SIZE = 4U * 1024U * 1024U;
+
+// the arena grows, so a workload which never resets it does not run out of memory
+using BumpPointerAdapter = AllocatorAdapter<BumpPointerAllocator<ADAPTER_POOL_SIZE, true>>;
+using RunOfSlotsAdapter =
+    AllocatorAdapter<RunOfSlotsAllocator<ADAPTER_POOL_SIZE, 16U, 32U, 64U, 128U, 256U, 512U, 1024U>>;
+using FreeListAdapter = AllocatorAdapter<FreeListAllocator<ADAPTER_POOL_SIZE>>;
+
+#endif  // MEMORY_MANAGEMENT_BENCHMARKS_INCLUDE_ALLOCATOR_ADAPTERS_H
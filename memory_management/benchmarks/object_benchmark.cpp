@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "memory_management/reference_counting_gc/include/deferred_release.h"
+#include "memory_management/reference_counting_gc/include/object_module.h"
+#include "memory_management/reference_counting_gc/include/object_ref.h"
+#include "memory_management/reference_counting_gc/include/ref_count.h"
+
+namespace {
+constexpr size_t CHAIN_LENGTH = 1000U;
+
+// copy takes and drops a reference
+template <class RefCount>
+void BM_ObjectCopy(benchmark::State &state)
+{
+    auto obj = MakeObject<size_t, RefCount>(0U);
+    for (auto _ : state) {
+        Object<size_t, RefCount> copy = obj;  // NOLINT(performance-unnecessary-copy-initialization)
+        benchmark::DoNotOptimize(copy.Get());
+    }
+}
+
+void BM_SharedPtrCopy(benchmark::State &state)
+{
+    auto ptr = std::make_shared<size_t>(0U);
+    for (auto _ : state) {
+        std::shared_ptr<size_t> copy = ptr;  // NOLINT(performance-unnecessary-copy-initialization)
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+
+template <class RefCount>
+void BM_ObjectMove(benchmark::State &state)
+{
+    auto obj = MakeObject<size_t, RefCount>(0U);
+    for (auto _ : state) {
+        Object<size_t, RefCount> moved = std::move(obj);
+        benchmark::DoNotOptimize(moved.Get());
+        obj = std::move(moved);
+    }
+}
+
+// creation and destruction of an object with its block
+template <class RefCount>
+void BM_ObjectCreateDestroy(benchmark::State &state)
+{
+    for (auto _ : state) {
+        auto obj = MakeObject<size_t, RefCount>(0U);
+        benchmark::DoNotOptimize(obj.Get());
+    }
+}
+
+// calls are not inlined, so the copy of the argument is not optimized out
+__attribute__((noinline)) size_t ReadOwned(Object<size_t> obj)  // NOLINT(performance-unnecessary-value-param)
+{
+    return *obj;
+}
+
+__attribute__((noinline)) size_t ReadBorrowed(ObjectRef<size_t> ref)
+{
+    return *ref;
+}
+
+void BM_PassObject(benchmark::State &state)
+{
+    auto obj = MakeObject<size_t>(0U);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ReadOwned(obj));
+    }
+}
+
+void BM_PassObjectRef(benchmark::State &state)
+{
+    auto obj = MakeObject<size_t>(0U);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ReadBorrowed(obj));
+    }
+}
+
+template <class RefCount>
+struct ChainNode {
+    Object<ChainNode, RefCount> next;
+};
+
+// release of a chain of CHAIN_LENGTH objects, deferred objects are destroyed by DrainReleases()
+template <class RefCount>
+void BM_ChainDestroy(benchmark::State &state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto head = MakeObject<ChainNode<RefCount>, RefCount>();
+        ChainNode<RefCount> *tail = head.Get();
+        for (size_t i = 1U; i < CHAIN_LENGTH; ++i) {
+            tail->next = MakeObject<ChainNode<RefCount>, RefCount>();
+            tail = tail->next.Get();
+        }
+        state.ResumeTiming();
+        head.Reset(nullptr);
+        DrainReleases();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * CHAIN_LENGTH));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ObjectCopy, NonAtomicRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectCopy, AtomicRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectCopy, BiasedRefCount);
+BENCHMARK(BM_SharedPtrCopy);
+BENCHMARK_TEMPLATE(BM_ObjectMove, NonAtomicRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectMove, AtomicRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectMove, BiasedRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectCreateDestroy, NonAtomicRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectCreateDestroy, AtomicRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectCreateDestroy, BiasedRefCount);
+BENCHMARK_TEMPLATE(BM_ObjectCreateDestroy, DeferredRefCount);
+BENCHMARK(BM_PassObject);
+BENCHMARK(BM_PassObjectRef);
+BENCHMARK_TEMPLATE(BM_ChainDestroy, NonAtomicRefCount);
+BENCHMARK_TEMPLATE(BM_ChainDestroy, DeferredRefCount);
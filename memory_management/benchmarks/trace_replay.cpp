@@ -0,0 +1,238 @@
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "memory_management/benchmarks/include/allocator_adapters.h"
+#include "memory_management/common/include/allocation_trace.h"
+
+/**
+ * Replays a trace written by TracingAllocator (see allocation_trace.h) against allocators of the project and malloc:
+ *   trace_replay <trace file> [malloc] [bump] [ros] [freelist]
+ * All of them are replayed if none is given. Events of all threads are replayed by one thread in the recorded order,
+ * every allocation is filled like the traced program would write it. Each allocator runs in its own process, so the
+ * peak RSS is its own. Fragmentation is 1 - peak live bytes / peak of the RSS growth, where the growth is counted
+ * from the RSS before the replay; it is only meaningful for traces much bigger than a page.
+ * Size classes and pool sizes are those of allocator_adapters.h, change them there to try other configurations.
+ */
+
+namespace {
+constexpr size_t KIB = 1024U;
+
+struct ReplayResult {
+    double milliseconds = 0.0;
+    size_t peakLiveBytes = 0U;
+    size_t baselineRssBytes = 0U;
+    size_t peakRssBytes = 0U;
+    // allocations which returned nullptr, their frees are skipped
+    size_t failures = 0U;
+};
+
+// @returns value of @param field of /proc/self/status in bytes, 0 if there is no such field
+size_t ReadStatusBytes(const char *field)
+{
+    std::FILE *file = std::fopen("/proc/self/status", "r");
+    if (file == nullptr) {
+        return 0U;
+    }
+    size_t fieldLength = std::strlen(field);
+    size_t kib = 0U;
+    char line[256];  // NOLINT(modernize-avoid-c-arrays)
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        if (std::strncmp(line, field, fieldLength) == 0 && line[fieldLength] == ':') {
+            kib = std::strtoull(line + fieldLength + 1U, nullptr, 10);  // NOLINT(readability-magic-numbers)
+            break;
+        }
+    }
+    std::fclose(file);
+    return kib * KIB;
+}
+
+// resets the peak RSS reported as VmHWM to the current RSS, @returns false if the kernel does not support it
+bool ResetPeakRss()
+{
+    std::FILE *file = std::fopen("/proc/self/clear_refs", "w");
+    if (file == nullptr) {
+        return false;
+    }
+    bool reset = std::fputs("5", file) >= 0;
+    return std::fclose(file) == 0 && reset;
+}
+
+// the largest pointer id of @param events plus 1
+size_t IdsCount(const std::vector<TraceEvent> &events)
+{
+    size_t count = 0U;
+    for (const TraceEvent &event : events) {
+        if (event.kind == TraceEventKind::ALLOCATE && event.pointerId >= count) {
+            count = event.pointerId + 1U;
+        }
+    }
+    return count;
+}
+
+template <class Adapter>
+ReplayResult Replay(const std::vector<TraceEvent> &events)
+{
+    ReplayResult result;
+    std::vector<void *> ptrs(IdsCount(events), nullptr);
+    std::vector<size_t> sizes(ptrs.size(), 0U);
+    auto adapter = std::make_unique<Adapter>();
+    if (!ResetPeakRss()) {
+        std::fprintf(stderr, "peak RSS can not be reset, it includes the memory of the parent\n");
+    }
+    result.baselineRssBytes = ReadStatusBytes("VmRSS");
+    size_t liveBytes = 0U;
+    // allocations made before the last FREE_ALL are not live
+    size_t firstLiveId = 0U;
+    size_t nextId = 0U;
+    auto start = std::chrono::steady_clock::now();
+    for (const TraceEvent &event : events) {
+        switch (event.kind) {
+            case TraceEventKind::ALLOCATE: {
+                void *mem = adapter->Allocate(event.size, size_t {1U} << event.alignLog2);
+                if (mem == nullptr) {
+                    ++result.failures;
+                    break;
+                }
+                std::memset(mem, 0, event.size);
+                ptrs[event.pointerId] = mem;
+                sizes[event.pointerId] = event.size;
+                nextId = event.pointerId + 1U;
+                liveBytes += event.size;
+                result.peakLiveBytes = liveBytes > result.peakLiveBytes ? liveBytes : result.peakLiveBytes;
+                break;
+            }
+            case TraceEventKind::FREE:
+                if (event.pointerId < ptrs.size() && ptrs[event.pointerId] != nullptr) {
+                    adapter->Free(ptrs[event.pointerId]);
+                    ptrs[event.pointerId] = nullptr;
+                    liveBytes -= sizes[event.pointerId];
+                }
+                break;
+            case TraceEventKind::FREE_ALL:
+                // allocators which free memory one by one get every live allocation freed
+                for (size_t id = firstLiveId; id < nextId; ++id) {
+                    if (ptrs[id] != nullptr) {
+                        adapter->Free(ptrs[id]);
+                        ptrs[id] = nullptr;
+                    }
+                }
+                adapter->Reset();
+                firstLiveId = nextId;
+                liveBytes = 0U;
+                break;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+    result.peakRssBytes = ReadStatusBytes("VmHWM");
+    return result;
+}
+
+// runs @param replay in a child process, @returns false if it failed
+bool RunInChild(ReplayResult (*replay)(const std::vector<TraceEvent> &), const std::vector<TraceEvent> &events,
+                ReplayResult &result)
+{
+    int fds[2];  // NOLINT(modernize-avoid-c-arrays)
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    // the child should not write what is buffered again
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        ReplayResult childResult = replay(events);
+        bool written = write(fds[1], &childResult, sizeof(childResult)) == sizeof(childResult);
+        close(fds[1]);
+        _exit(written ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(fds[1]);
+    bool read = ::read(fds[0], &result, sizeof(result)) == sizeof(result);
+    close(fds[0]);
+    int status = 0;
+    bool exited = waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+    return read && exited;
+}
+
+struct Replayer {
+    const char *name;
+    ReplayResult (*replay)(const std::vector<TraceEvent> &);
+};
+
+// NOLINTNEXTLINE(modernize-avoid-c-arrays)
+const Replayer REPLAYERS[] = {
+    {"malloc", Replay<MallocAdapter>},
+    {"bump", Replay<BumpPointerAdapter>},
+    {"ros", Replay<RunOfSlotsAdapter>},
+    {"freelist", Replay<FreeListAdapter>},
+};
+
+void PrintResult(const char *name, const ReplayResult &result)
+{
+    size_t growth = result.peakRssBytes > result.baselineRssBytes ? result.peakRssBytes - result.baselineRssBytes : 0U;
+    double fragmentation = growth <= result.peakLiveBytes ? 0.0
+                                                          : 1.0 - static_cast<double>(result.peakLiveBytes) /
+                                                                      static_cast<double>(growth);
+    std::printf("%-10s %12.3f %15zu %15zu %14.3f %10zu\n", name, result.milliseconds, result.peakLiveBytes / KIB,
+                result.peakRssBytes / KIB, fragmentation, result.failures);
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace file> [malloc] [bump] [ros] [freelist]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    std::vector<TraceEvent> events;
+    if (!ReadTrace(argv[1], events)) {
+        std::fprintf(stderr, "%s is not a readable trace\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    std::vector<const Replayer *> chosen;
+    for (int i = 2; i < argc; ++i) {
+        const Replayer *found = nullptr;
+        for (const Replayer &replayer : REPLAYERS) {
+            if (std::string(argv[i]) == replayer.name) {
+                found = &replayer;
+            }
+        }
+        if (found == nullptr) {
+            std::fprintf(stderr, "unknown allocator %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        chosen.push_back(found);
+    }
+    if (chosen.empty()) {
+        for (const Replayer &replayer : REPLAYERS) {
+            chosen.push_back(&replayer);
+        }
+    }
+    std::printf("%zu events\n", events.size());
+    std::printf("%-10s %12s %15s %15s %14s %10s\n", "allocator", "time_ms", "peak_live_kib", "peak_rss_kib",
+                "fragmentation", "failures");
+    int status = EXIT_SUCCESS;
+    for (const Replayer *replayer : chosen) {
+        ReplayResult result;
+        if (!RunInChild(replayer->replay, events, result)) {
+            std::fprintf(stderr, "replay against %s failed\n", replayer->name);
+            status = EXIT_FAILURE;
+            continue;
+        }
+        PrintResult(replayer->name, result);
+    }
+    return status;
+}
@@ -1,42 +1,389 @@
 #ifndef MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
 #define MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
 
+#include <array>
 #include <cstddef>  // is used for size_t
 #include <cstdint>
+#include <cstring>
+#include <new>
+#include "base/alignment.h"
 #include "base/macros.h"
+#include "memory_management/common/include/allocator_stats.h"
+#include "memory_management/common/include/os_pages.h"
+#include "memory_management/common/include/page_source.h"
 
-template <size_t MEMORY_POOL_SIZE>
+/**
+ * @brief Allocates memory by bumping a pointer in a pool of MEMORY_POOL_SIZE bytes.
+ * If GROWABLE is set, running out of the pool links in a new chunk taken from PageSource (see page_source.h), every
+ * next chunk is at least twice as big as the previous one. Free() and Rewind() give these chunks back.
+ * The first pool is always stored inside the allocator.
+ */
+template <size_t MEMORY_POOL_SIZE, bool GROWABLE = false, class PageSource = MmapPageSource>
 class BumpPointerAllocator {
+    static_assert(MEMORY_POOL_SIZE != 0, "memory pool can not be empty");
+
+    static constexpr size_t BITS_IN_WORD = 64U;
+    // alignment of every chunk data
+    static constexpr size_t DATA_ALIGN = alignof(std::max_align_t);
+    static constexpr size_t STARTS_WORDS = (MEMORY_POOL_SIZE + BITS_IN_WORD - 1U) / BITS_IN_WORD;
+
+    // describes one chunk of memory; the first chunk is stored inside the allocator, others are taken from PageSource
+    struct Chunk {
+        Chunk *prev;
+        uint8_t *data;
+        // one bit per byte of the chunk, set for the first byte of every allocation
+        uint64_t *starts;
+        size_t capacity;
+        size_t top;
+        size_t mappedSize;
+    };
+
 public:
+    /**
+     * @brief Position of the bump pointer returned by Mark(). It can only be passed to Rewind() of the same allocator
+     */
+    class Marker {
+    public:
+        Marker() = default;
+
+    private:
+        Marker(Chunk *chunk, size_t offset) : chunk_(chunk), offset_(offset) {}
+
+        // nullptr stands for the first chunk
+        Chunk *chunk_ = nullptr;
+        size_t offset_ = 0U;
+
+        friend class BumpPointerAllocator;
+    };
+
+    /**
+     * @brief RAII guard: frees everything allocated during its lifetime when it goes out of scope
+     */
+    class Scope {
+    public:
+        explicit Scope(BumpPointerAllocator &allocator) : allocator_(allocator), marker_(allocator.Mark()) {}
+        ~Scope()
+        {
+            allocator_.Rewind(marker_);
+        }
+        NO_COPY_SEMANTIC(Scope);
+        NO_MOVE_SEMANTIC(Scope);
+
+    private:
+        BumpPointerAllocator &allocator_;
+        Marker marker_;
+    };
+
     BumpPointerAllocator() = default;
-    ~BumpPointerAllocator() = default;
+    explicit BumpPointerAllocator(PageSource source) : source_(source) {}
+    ~BumpPointerAllocator()
+    {
+        ReleaseChunksAfter(&first_);
+    }
     NO_COPY_SEMANTIC(BumpPointerAllocator);
     NO_MOVE_SEMANTIC(BumpPointerAllocator);
 
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned to alignof(T)
+     */
+    template <class T = uint8_t>
+    T *Allocate(size_t count)
+    {
+        return AllocateAligned<T>(count, alignof(T));
+    }
+
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned to @param align
+     * @param align should be a power of two, alignment less than alignof(T) is raised to alignof(T)
+     */
+    template <class T = uint8_t>
+    T *AllocateAligned(size_t count, size_t align)
+    {
+        T *mem = BumpAllocate<T>(count, align);
+        STATS_ONLY(counters_.OnAllocate(mem != nullptr));
+        return mem;
+    }
+
+    /**
+     * @brief Resizes memory of @param ptr to @param newCount objects of type T. The most recent allocation is resized
+     * in place while it fits into its chunk, unless Mark() was called after it. Otherwise new memory aligned to
+     * alignof(T) is allocated and the contents are copied bytewise, the old memory stays allocated till Free() or
+     * Rewind()
+     * @returns new address of the memory or nullptr if there is no memory, @param ptr stays valid in that case
+     */
     template <class T = uint8_t>
-    T *Allocate([[maybe_unused]] size_t count)  // TODO(you): remove [[maybe_unused]]
+    T *Reallocate(T *ptr, size_t newCount)
     {
-        // TODO(you): Add your implementation here...
-        return nullptr;
+        if (ptr == nullptr) {
+            return Allocate<T>(newCount);
+        }
+        if (UNLIKELY(newCount == 0U)) {
+            return nullptr;
+        }
+        auto *mem = reinterpret_cast<uint8_t *>(ptr);
+        if (mem == last_) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            auto offset = static_cast<size_t>(mem - current_->data);
+            if (newCount <= (current_->capacity - offset) / sizeof(T)) {
+                current_->top = offset + newCount * sizeof(T);
+                return ptr;
+            }
+        }
+        Chunk *chunk = ChunkOf(mem);
+        // end of the allocation is not kept, it is the start of the next one or the top
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto offset = static_cast<size_t>(mem - chunk->data);
+        size_t oldSize = NextStart(chunk, offset + 1U) - offset;
+        T *newMem = Allocate<T>(newCount);
+        if (newMem != nullptr) {
+            std::memcpy(newMem, ptr, oldSize < newCount * sizeof(T) ? oldSize : newCount * sizeof(T));
+        }
+        return newMem;
     }
 
+    /**
+     * @brief Allocates @param count separate objects of type T and writes their addresses to @param out.
+     * Objects are placed back to back, so the bump pointer is moved once for the whole batch
+     * @returns count of allocated objects: either @param count or 0
+     */
+    template <class T = uint8_t>
+    size_t AllocateBatch(size_t count, T **out)
+    {
+        T *mem = BumpAllocate<T>(count, alignof(T));
+        STATS_ONLY(counters_.OnAllocateBatch(count, mem == nullptr ? 0U : count));
+        if (mem == nullptr) {
+            return 0U;
+        }
+        // the batch is at the end of the current chunk, the first start bit is already set
+        size_t offset = reinterpret_cast<uintptr_t>(mem) - reinterpret_cast<uintptr_t>(current_->data);
+        for (size_t i = 0; i < count; ++i) {
+            SetStart(current_, offset + i * sizeof(T));
+            out[i] = mem + i;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        last_ = reinterpret_cast<uint8_t *>(out[count - 1U]);
+        return count;
+    }
+
+    /**
+     * @brief Frees all allocated memory. In GROWABLE mode every chunk except the first one is returned to PageSource
+     */
     void Free()
     {
-        // TODO(you): Add your implementation here...
+        ReleaseChunksAfter(&first_);
+        ClearStarts(&first_, 0U, first_.top);
+        first_.top = 0U;
+        last_ = nullptr;
+        STATS_ONLY(counters_.OnFree());
+    }
+
+    /**
+     * @brief Remembers current position of the bump pointer
+     * @returns marker which can be used to free all memory allocated after this call
+     */
+    Marker Mark()
+    {
+        // allocations made before the marker are not resized in place, so they can not move the top across it
+        last_ = nullptr;
+        return Marker(current_ == &first_ ? nullptr : current_, current_->top);
+    }
+
+    /**
+     * @brief Frees all memory allocated after @param marker was taken. Markers taken after @param marker become invalid
+     */
+    void Rewind(Marker marker)
+    {
+        Chunk *chunk = marker.chunk_ == nullptr ? &first_ : marker.chunk_;
+        ReleaseChunksAfter(chunk);
+        // marker taken after an earlier rewind is invalid
+        assert(marker.offset_ <= chunk->top);
+        ClearStarts(chunk, marker.offset_, chunk->top);
+        last_ = nullptr;
+        STATS_ONLY(counters_.OnFree());
+        chunk->top = marker.offset_;
     }
 
     /**
      * @brief Method should check in @param ptr is pointer to mem from this allocator
      * @returns true if ptr is from this allocator
      */
-    bool VerifyPtr([[maybe_unused]] void *ptr)  // TODO(you): remove [[maybe_unused]]
+    bool VerifyPtr(void *ptr)
     {
-        // TODO(you): Add your implementation here...
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        for (Chunk *chunk = current_; chunk != nullptr; chunk = chunk->prev) {
+            auto begin = reinterpret_cast<uintptr_t>(chunk->data);
+            if (addr >= begin && addr < begin + chunk->top) {
+                size_t offset = addr - begin;
+                return (chunk->starts[offset / BITS_IN_WORD] & (uint64_t {1U} << (offset % BITS_IN_WORD))) != 0U;
+            }
+        }
         return false;
     }
 
+#ifdef ALLOCATOR_STATS
+    AllocatorStats GetStats() const
+    {
+        AllocatorStats stats;
+        stats.reservedBytes = sizeof(BumpPointerAllocator);
+        for (const Chunk *chunk = current_; chunk != nullptr; chunk = chunk->prev) {
+            ++stats.poolsCount;
+            stats.liveBytes += chunk->top;
+            stats.reservedBytes += chunk->mappedSize;
+            stats.freeBytes += chunk->capacity - chunk->top;
+        }
+        // only the current chunk is used for new allocations
+        stats.largestFreeBlock = current_->capacity - current_->top;
+        counters_.Finish(stats);
+        return stats;
+    }
+#endif
+
 private:
-    // TODO(you): Add your fields and methods here...
+    template <class T>
+    T *BumpAllocate(size_t count, size_t align)
+    {
+        if (UNLIKELY(count == 0U || !IsPowerOfTwo(align))) {
+            return nullptr;
+        }
+        align = align < alignof(T) ? alignof(T) : align;
+        Chunk *chunk = current_;
+        size_t offset = AlignedTop(chunk, align);
+        if (UNLIKELY(offset > chunk->capacity || count > (chunk->capacity - offset) / sizeof(T))) {
+            if constexpr (!GROWABLE) {
+                return nullptr;
+            } else {
+                if (count > (SIZE_MAX - align) / sizeof(T)) {
+                    return nullptr;
+                }
+                // new chunk data is aligned to DATA_ALIGN, bigger alignment may need padding
+                size_t padding = align > DATA_ALIGN ? align - DATA_ALIGN : 0U;
+                chunk = Grow(count * sizeof(T) + padding);
+                if (chunk == nullptr) {
+                    return nullptr;
+                }
+                offset = AlignedTop(chunk, align);
+            }
+        }
+        SetStart(chunk, offset);
+        chunk->top = offset + count * sizeof(T);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        last_ = chunk->data + offset;
+        return reinterpret_cast<T *>(last_);
+    }
+
+    static void SetStart(Chunk *chunk, size_t offset)
+    {
+        chunk->starts[offset / BITS_IN_WORD] |= uint64_t {1U} << (offset % BITS_IN_WORD);
+    }
+
+    // clears allocation start bits in range [from, to)
+    static void ClearStarts(Chunk *chunk, size_t from, size_t to)
+    {
+        if (from >= to) {
+            return;
+        }
+        uint64_t *starts = chunk->starts;
+        size_t firstWord = from / BITS_IN_WORD;
+        size_t lastWord = (to - 1U) / BITS_IN_WORD;
+        uint64_t firstMask = ~uint64_t {0U} << (from % BITS_IN_WORD);
+        uint64_t lastMask = ~uint64_t {0U} >> (BITS_IN_WORD - 1U - (to - 1U) % BITS_IN_WORD);
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (firstWord == lastWord) {
+            starts[firstWord] &= ~(firstMask & lastMask);
+            return;
+        }
+        starts[firstWord] &= ~firstMask;
+        for (size_t i = firstWord + 1U; i < lastWord; ++i) {
+            starts[i] = 0U;
+        }
+        starts[lastWord] &= ~lastMask;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    // @returns chunk containing @param mem, which should be allocated by this allocator
+    Chunk *ChunkOf(const uint8_t *mem) const
+    {
+        Chunk *chunk = current_;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        while (mem < chunk->data || mem >= chunk->data + chunk->top) {
+            chunk = chunk->prev;
+        }
+        return chunk;
+    }
+
+    // @returns offset of the first allocation start not before @param from or the chunk top if there is none
+    static size_t NextStart(const Chunk *chunk, size_t from)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (size_t word = from / BITS_IN_WORD; word * BITS_IN_WORD < chunk->top; ++word) {
+            uint64_t starts = chunk->starts[word];
+            if (word == from / BITS_IN_WORD) {
+                starts &= ~uint64_t {0U} << (from % BITS_IN_WORD);
+            }
+            if (starts != 0U) {
+                size_t start = word * BITS_IN_WORD + static_cast<size_t>(__builtin_ctzll(starts));
+                return start < chunk->top ? start : chunk->top;
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return chunk->top;
+    }
+
+    // @returns offset of the first byte after the chunk top which is aligned to @param align
+    static size_t AlignedTop(Chunk *chunk, size_t align)
+    {
+        auto begin = reinterpret_cast<uintptr_t>(chunk->data);
+        return AlignUp(begin + chunk->top, align) - begin;
+    }
+
+    // takes a new chunk which can hold at least @param size bytes and makes it current
+    NO_INLINE Chunk *Grow(size_t size)
+    {
+        constexpr size_t MAX_CAPACITY = SIZE_MAX / 4U;
+        size_t capacity = current_->capacity;
+        do {
+            if (capacity > MAX_CAPACITY) {
+                return nullptr;
+            }
+            capacity *= 2U;
+        } while (capacity < size);
+
+        size_t startsSize = (capacity + BITS_IN_WORD - 1U) / BITS_IN_WORD * sizeof(uint64_t);
+        size_t dataOffset = AlignUp(sizeof(Chunk) + startsSize, DATA_ALIGN);
+        size_t mappedSize = AlignUp(dataOffset + capacity, PageSize());
+        void *mem = source_.Map(mappedSize, DATA_ALIGN);
+        if (mem == nullptr) {
+            return nullptr;
+        }
+        auto *base = static_cast<uint8_t *>(mem);
+        // memory of the source may be not zeroed
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memset(base + sizeof(Chunk), 0, startsSize);
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        current_ = new (mem) Chunk {current_, base + dataOffset, reinterpret_cast<uint64_t *>(base + sizeof(Chunk)),
+                                    capacity, 0U, mappedSize};
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return current_;
+    }
+
+    // returns to PageSource all chunks taken after @param chunk and makes it current
+    void ReleaseChunksAfter(Chunk *chunk)
+    {
+        while (current_ != chunk) {
+            Chunk *prev = current_->prev;
+            source_.Unmap(current_, current_->mappedSize, DATA_ALIGN);
+            current_ = prev;
+        }
+    }
+
+    alignas(DATA_ALIGN) std::array<uint8_t, MEMORY_POOL_SIZE> pool_ {};
+    std::array<uint64_t, STARTS_WORDS> firstStarts_ {};
+    Chunk first_ {nullptr, pool_.data(), firstStarts_.data(), MEMORY_POOL_SIZE, 0U, 0U};
+    Chunk *current_ = &first_;
+    // the most recent allocation, it can be resized in place
+    uint8_t *last_ = nullptr;
+    PageSource source_ {};
+    STATS_ONLY(AllocatorCounters counters_;)
 };
 
-#endif  // MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
\ No newline at end of file
+#endif  // MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_BUMP_POINTER_ALLOCATOR_H
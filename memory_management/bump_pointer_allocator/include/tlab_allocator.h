@@ -0,0 +1,168 @@
+#ifndef MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_TLAB_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_TLAB_ALLOCATOR_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "base/alignment.h"
+#include "base/macros.h"
+
+/**
+ * @brief Concurrent bump pointer allocator with thread-local allocation buffers (TLABs).
+ * Every thread creates its own ThreadLocalBuffer and bump-allocates from it without any synchronization. Only
+ * carving a new buffer of TLAB_SIZE bytes out of the shared pool of MEMORY_POOL_SIZE bytes touches an atomic.
+ * Requests bigger than TLAB_SIZE get a slice of their own, so the current buffer is not wasted.
+ */
+template <size_t MEMORY_POOL_SIZE, size_t TLAB_SIZE = 4096U>
+class TlabAllocator {
+    static_assert(MEMORY_POOL_SIZE != 0, "memory pool can not be empty");
+
+    static constexpr size_t BITS_IN_WORD = 64U;
+    static constexpr size_t STARTS_WORDS = (MEMORY_POOL_SIZE + BITS_IN_WORD - 1U) / BITS_IN_WORD;
+    // slices are aligned to the bits in one word of the starts bitmap, so every word belongs to only one thread
+    static constexpr size_t SLICE_ALIGN = BITS_IN_WORD;
+    static_assert(TLAB_SIZE != 0 && TLAB_SIZE % SLICE_ALIGN == 0, "TLAB size should be a multiple of 64");
+
+public:
+    /**
+     * @brief Allocation buffer which should be used by one thread only
+     */
+    class ThreadLocalBuffer {
+    public:
+        explicit ThreadLocalBuffer(TlabAllocator &allocator) : allocator_(allocator) {}
+        ~ThreadLocalBuffer() = default;
+        NO_COPY_SEMANTIC(ThreadLocalBuffer);
+        NO_MOVE_SEMANTIC(ThreadLocalBuffer);
+
+        template <class T = uint8_t>
+        T *Allocate(size_t count)
+        {
+            return AllocateAligned<T>(count, alignof(T));
+        }
+
+        /**
+         * @brief Allocates memory for @param count objects of type T aligned to @param align
+         * @param align should be a power of two, alignment less than alignof(T) is raised to alignof(T)
+         */
+        template <class T = uint8_t>
+        T *AllocateAligned(size_t count, size_t align)
+        {
+            if (UNLIKELY(count == 0U || !IsPowerOfTwo(align) || count > MEMORY_POOL_SIZE / sizeof(T))) {
+                return nullptr;
+            }
+            align = align < alignof(T) ? alignof(T) : align;
+            size_t size = count * sizeof(T);
+            uintptr_t mem = AlignUp(top_, align);
+            if (UNLIKELY(mem < top_ || mem > end_ || size > end_ - mem)) {
+                mem = Refill(size, align);
+                if (mem == 0U) {
+                    return nullptr;
+                }
+            } else {
+                top_ = mem + size;
+            }
+            allocator_.SetStart(mem);
+            return reinterpret_cast<T *>(mem);
+        }
+
+        /**
+         * @brief Drops the rest of the buffer. Should be called for every buffer before TlabAllocator::Free()
+         */
+        void Reset()
+        {
+            top_ = 0U;
+            end_ = 0U;
+        }
+
+    private:
+        // @returns memory for the request which does not fit into the buffer
+        NO_INLINE uintptr_t Refill(size_t size, size_t align)
+        {
+            size_t padding = align > SLICE_ALIGN ? align - SLICE_ALIGN : 0U;
+            if (size + padding > TLAB_SIZE) {
+                // big request gets its own slice and the current buffer stays in use
+                uintptr_t slice = allocator_.CarveSlice(AlignUp(size + padding, SLICE_ALIGN));
+                return slice == 0U ? 0U : AlignUp(slice, align);
+            }
+            uintptr_t slice = allocator_.CarveSlice(TLAB_SIZE);
+            if (slice == 0U) {
+                return 0U;
+            }
+            uintptr_t mem = AlignUp(slice, align);
+            top_ = mem + size;
+            end_ = slice + TLAB_SIZE;
+            return mem;
+        }
+
+        TlabAllocator &allocator_;
+        uintptr_t top_ = 0U;
+        uintptr_t end_ = 0U;
+    };
+
+    TlabAllocator() = default;
+    ~TlabAllocator() = default;
+    NO_COPY_SEMANTIC(TlabAllocator);
+    NO_MOVE_SEMANTIC(TlabAllocator);
+
+    /**
+     * @brief Frees all allocated memory. It is not thread safe: no buffer should be used concurrently,
+     * and every buffer should be Reset() before its next allocation
+     */
+    void Free()
+    {
+        size_t top = top_.load(std::memory_order_relaxed);
+        size_t words = (top < MEMORY_POOL_SIZE ? top : MEMORY_POOL_SIZE) / BITS_IN_WORD;
+        for (size_t i = 0; i < words; ++i) {
+            starts_[i].store(0U, std::memory_order_relaxed);
+        }
+        top_.store(0U, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Method should check in @param ptr is pointer to mem from this allocator
+     * @returns true if ptr is from this allocator
+     */
+    bool VerifyPtr(void *ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        auto begin = reinterpret_cast<uintptr_t>(pool_.data());
+        if (addr < begin || addr >= begin + top_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        size_t offset = addr - begin;
+        uint64_t word = starts_[offset / BITS_IN_WORD].load(std::memory_order_relaxed);
+        return (word & (uint64_t {1U} << (offset % BITS_IN_WORD))) != 0U;
+    }
+
+private:
+    // @returns address of a new slice of @param size bytes or 0 if the pool is exhausted
+    uintptr_t CarveSlice(size_t size)
+    {
+        size_t top = top_.load(std::memory_order_relaxed);
+        size_t end = 0U;
+        do {
+            if (top > MEMORY_POOL_SIZE || size > MEMORY_POOL_SIZE - top) {
+                return 0U;
+            }
+            end = top + size;
+        } while (!top_.compare_exchange_weak(top, end, std::memory_order_acq_rel, std::memory_order_relaxed));
+        return reinterpret_cast<uintptr_t>(pool_.data()) + top;
+    }
+
+    void SetStart(uintptr_t mem)
+    {
+        size_t offset = mem - reinterpret_cast<uintptr_t>(pool_.data());
+        // only the owner of the slice writes this word, so there is no need in read-modify-write
+        auto &word = starts_[offset / BITS_IN_WORD];
+        word.store(word.load(std::memory_order_relaxed) | (uint64_t {1U} << (offset % BITS_IN_WORD)),
+                   std::memory_order_relaxed);
+    }
+
+    alignas(CACHE_LINE_SIZE) std::array<uint8_t, MEMORY_POOL_SIZE> pool_ {};
+    // one bit per byte of the pool, set for the first byte of every allocation
+    std::array<std::atomic<uint64_t>, STARTS_WORDS> starts_ {};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> top_ {0U};
+};
+
+#endif  // MEMORY_MANAGEMENT_BUMP_POINTER_ALLOCATOR_INCLUDE_TLAB_ALLOCATOR_H
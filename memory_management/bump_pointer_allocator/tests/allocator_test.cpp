@@ -1,9 +1,15 @@
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
 #include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+#include "memory_management/common/include/stl_adapters.h"
 
-TEST(BumpAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ prefix to use test
+TEST(BumpAllocatorTest, TemplateAllocationTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 4048U;
     BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
@@ -22,7 +28,7 @@ TEST(BumpAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ pr
     ASSERT_EQ(allocator.Allocate<char>(0), nullptr);  // you can not allocate memory with 0 size
 }
 
-TEST(BumpAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABLED_ prefix to use test
+TEST(BumpAllocatorTest, AllocatorMemPoolOverflowTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 64U;
     BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
@@ -38,4 +44,266 @@ TEST(BumpAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABL
     ASSERT_EQ(allocator.Allocate<char>(5U), mem);
     allocator.Free();
     ASSERT_EQ(allocator.Allocate<size_t>(10U), nullptr);
-}
\ No newline at end of file
+}
+
+TEST(BumpAllocatorTest, MarkRewindTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 256U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *parse = allocator.Allocate<char>(16U);
+    ASSERT_NE(parse, nullptr);
+    auto marker = allocator.Mark();
+    auto *plan = allocator.Allocate<char>(32U);
+    ASSERT_NE(plan, nullptr);
+    auto innerMarker = allocator.Mark();
+    auto *execute = allocator.Allocate<char>(64U);
+    ASSERT_NE(execute, nullptr);
+
+    allocator.Rewind(innerMarker);
+    ASSERT_FALSE(allocator.VerifyPtr(execute));
+    ASSERT_TRUE(allocator.VerifyPtr(plan));
+    ASSERT_EQ(allocator.Allocate<char>(64U), execute);  // memory after the marker is reused
+
+    allocator.Rewind(marker);
+    ASSERT_TRUE(allocator.VerifyPtr(parse));
+    ASSERT_FALSE(allocator.VerifyPtr(plan));
+    ASSERT_FALSE(allocator.VerifyPtr(execute));
+    ASSERT_EQ(allocator.Allocate<char>(MEMORY_POOL_SIZE - 16U), plan);  // whole rest of the pool is available
+}
+
+TEST(BumpAllocatorTest, ScopeTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 128U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *outer = allocator.Allocate<size_t>(2U);
+    ASSERT_NE(outer, nullptr);
+    char *inner = nullptr;
+    {
+        BumpPointerAllocator<MEMORY_POOL_SIZE>::Scope scope(allocator);
+        inner = allocator.Allocate<char>(MEMORY_POOL_SIZE - 2U * sizeof(size_t));
+        ASSERT_NE(inner, nullptr);
+        ASSERT_EQ(allocator.Allocate<char>(1U), nullptr);
+    }
+    ASSERT_TRUE(allocator.VerifyPtr(outer));
+    ASSERT_FALSE(allocator.VerifyPtr(inner));
+    ASSERT_EQ(allocator.Allocate<char>(1U), inner);
+}
+
+TEST(BumpAllocatorTest, GrowableChunksTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 64U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE, true> allocator;
+
+    auto *first = allocator.Allocate<char>(MEMORY_POOL_SIZE);
+    ASSERT_NE(first, nullptr);
+    auto *second = allocator.Allocate<char>(1U);  // does not fit into the first chunk
+    ASSERT_NE(second, nullptr);
+    constexpr size_t BIG_COUNT = 1024U;
+    auto *big = allocator.Allocate<size_t>(BIG_COUNT);  // bigger than the next geometric chunk
+    ASSERT_NE(big, nullptr);
+    big[BIG_COUNT - 1U] = BIG_COUNT;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_TRUE(allocator.VerifyPtr(first));
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    ASSERT_TRUE(allocator.VerifyPtr(big));
+    ASSERT_FALSE(allocator.VerifyPtr(big + 1U));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    allocator.Free();
+    ASSERT_FALSE(allocator.VerifyPtr(second));
+    ASSERT_FALSE(allocator.VerifyPtr(big));
+    ASSERT_EQ(allocator.Allocate<char>(MEMORY_POOL_SIZE), first);  // the first chunk is kept
+}
+
+TEST(BumpAllocatorTest, GrowableRewindTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 64U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE, true> allocator;
+
+    auto *first = allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U);
+    ASSERT_NE(first, nullptr);
+    auto marker = allocator.Mark();
+    auto *tail = allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U);
+    auto *chained = allocator.Allocate<char>(MEMORY_POOL_SIZE);
+    ASSERT_NE(chained, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(chained));
+
+    allocator.Rewind(marker);
+    ASSERT_TRUE(allocator.VerifyPtr(first));
+    ASSERT_FALSE(allocator.VerifyPtr(tail));
+    ASSERT_FALSE(allocator.VerifyPtr(chained));
+    ASSERT_EQ(allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U), tail);
+}
+
+TEST(BumpAllocatorTest, AlignmentTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 256U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *byte = allocator.Allocate<char>(1U);
+    ASSERT_NE(byte, nullptr);
+    auto *word = allocator.Allocate<size_t>(1U);
+    ASSERT_NE(word, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(word) % alignof(size_t), 0U);
+
+    auto *line = allocator.AllocateAligned<char>(1U, CACHE_LINE_SIZE);
+    ASSERT_NE(line, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(line) % CACHE_LINE_SIZE, 0U);
+    ASSERT_TRUE(allocator.VerifyPtr(line));
+    ASSERT_EQ(allocator.AllocateAligned<char>(1U, 3U), nullptr);  // alignment should be a power of two
+}
+
+TEST(BumpAllocatorTest, GrowableAlignmentTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 64U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE, true> allocator;
+
+    ASSERT_NE(allocator.Allocate<char>(MEMORY_POOL_SIZE - 1U), nullptr);
+    constexpr size_t PAGE_ALIGN = 4096U;
+    auto *page = allocator.AllocateAligned<char>(MEMORY_POOL_SIZE, PAGE_ALIGN);
+    ASSERT_NE(page, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(page) % PAGE_ALIGN, 0U);
+    ASSERT_TRUE(allocator.VerifyPtr(page));
+}
+
+TEST(BumpAllocatorTest, AllocateBatchTest)
+{
+    constexpr size_t BATCH_SIZE = 16U;
+    constexpr size_t MEMORY_POOL_SIZE = BATCH_SIZE * sizeof(uint64_t) + 1U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    ASSERT_NE(allocator.Allocate<uint8_t>(1U), nullptr);
+    std::array<uint64_t *, BATCH_SIZE> batch {};
+    ASSERT_EQ(allocator.AllocateBatch(BATCH_SIZE, batch.data()), 0U);  // does not fit after alignment
+
+    allocator.Free();
+    ASSERT_EQ(allocator.AllocateBatch(BATCH_SIZE, batch.data()), BATCH_SIZE);
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(batch[i]) % alignof(uint64_t), 0U);
+        ASSERT_TRUE(allocator.VerifyPtr(batch[i]));
+        if (i != 0U) {
+            ASSERT_EQ(batch[i], batch[i - 1U] + 1U);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            ASSERT_FALSE(allocator.VerifyPtr(reinterpret_cast<uint8_t *>(batch[i]) - 1U));
+        }
+    }
+}
+
+TEST(BumpAllocatorTest, ReallocateTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    constexpr size_t COUNT = 16U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *first = allocator.Allocate<uint32_t>(COUNT);
+    ASSERT_NE(first, nullptr);
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        first[i] = i;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    // the most recent allocation is extended in place
+    ASSERT_EQ(allocator.Reallocate(first, 2U * COUNT), first);
+    ASSERT_EQ(allocator.Reallocate(first, COUNT), first);
+    auto *second = allocator.Allocate<uint32_t>(1U);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_EQ(second, first + COUNT);
+
+    // older allocations are copied
+    auto *moved = allocator.Reallocate(first, 2U * COUNT);
+    ASSERT_NE(moved, nullptr);
+    ASSERT_NE(moved, first);
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(moved[i], i);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    ASSERT_EQ(allocator.Reallocate(moved, MEMORY_POOL_SIZE), nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(moved));
+}
+
+TEST(BumpAllocatorTest, ReallocateAfterMarkTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    constexpr size_t COUNT = 16U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE> allocator;
+
+    // memory allocated before the marker is not grown in place, the grown copy belongs to the marker
+    auto *grown = allocator.Allocate<uint32_t>(COUNT);
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        grown[i] = i;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    auto marker = allocator.Mark();
+    auto *copy = allocator.Reallocate(grown, 2U * COUNT);
+    ASSERT_NE(copy, nullptr);
+    ASSERT_NE(copy, grown);
+    allocator.Rewind(marker);
+    ASSERT_TRUE(allocator.VerifyPtr(grown));
+    ASSERT_FALSE(allocator.VerifyPtr(copy));
+    auto *next = allocator.Allocate<uint32_t>(COUNT);
+    ASSERT_EQ(next, grown + COUNT);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(grown[i], i);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    // shrinking can not move the top below the marker
+    auto *shrunk = allocator.Allocate<uint32_t>(COUNT);
+    marker = allocator.Mark();
+    ASSERT_NE(allocator.Reallocate(shrunk, 1U), nullptr);
+    allocator.Rewind(marker);
+    ASSERT_TRUE(allocator.VerifyPtr(shrunk));
+    auto *after = allocator.Allocate<uint32_t>(1U);
+    ASSERT_EQ(after, shrunk + COUNT);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    // allocations after the marker are still resized in place
+    marker = allocator.Mark();
+    auto *inner = allocator.Allocate<uint32_t>(COUNT);
+    ASSERT_EQ(allocator.Reallocate(inner, 2U * COUNT), inner);
+    allocator.Rewind(marker);
+    ASSERT_FALSE(allocator.VerifyPtr(inner));
+}
+
+TEST(BumpAllocatorTest, BufferPageSourceTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 64U;
+    constexpr size_t BUFFER_SIZE = 1U << 16U;
+    std::vector<uint8_t> buffer(BUFFER_SIZE);
+    BumpPointerAllocator<MEMORY_POOL_SIZE, true, BufferPageSource> allocator(
+        BufferPageSource(buffer.data(), buffer.size()));
+
+    ASSERT_NE(allocator.Allocate(MEMORY_POOL_SIZE), nullptr);
+    // grown chunks are cut from the buffer
+    auto *grown = allocator.Allocate(MEMORY_POOL_SIZE);
+    ASSERT_GE(grown, buffer.data());
+    ASSERT_LT(grown, buffer.data() + BUFFER_SIZE);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_TRUE(allocator.VerifyPtr(grown));
+    ASSERT_EQ(allocator.Allocate(BUFFER_SIZE), nullptr);
+
+    // the buffer is dirty, but starts of new chunks are cleared
+    allocator.Free();
+    std::fill(buffer.begin(), buffer.end(), uint8_t {0xFFU});
+    ASSERT_NE(allocator.Allocate(MEMORY_POOL_SIZE), nullptr);
+    grown = allocator.Allocate(MEMORY_POOL_SIZE);
+    ASSERT_TRUE(allocator.VerifyPtr(grown));
+    ASSERT_FALSE(allocator.VerifyPtr(grown + 1U));  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+TEST(BumpAllocatorTest, MemoryResourceTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 256U;
+    constexpr size_t COUNT = 1000U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE, true> allocator;
+    AllocatorMemoryResource resource(allocator);
+
+    // deallocation does nothing, the vector grows through new bump allocations
+    std::pmr::vector<size_t> values(&resource);
+    for (size_t i = 0; i < COUNT; ++i) {
+        values.push_back(i);
+    }
+    ASSERT_TRUE(allocator.VerifyPtr(values.data()));
+    for (size_t i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+
+    BumpPointerAllocator<MEMORY_POOL_SIZE> fixed;
+    std::vector<size_t, StlAllocator<size_t, decltype(fixed)>> small {StlAllocator<size_t, decltype(fixed)>(fixed)};
+    small.reserve(MEMORY_POOL_SIZE / sizeof(size_t));
+    ASSERT_TRUE(fixed.VerifyPtr(small.data()));
+    ASSERT_THROW(small.reserve(MEMORY_POOL_SIZE), std::bad_alloc);
+}
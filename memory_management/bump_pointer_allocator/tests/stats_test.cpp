@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+
+#ifndef ALLOCATOR_STATS
+#error "statistics tests should be built with ALLOCATOR_STATS"
+#endif
+
+TEST(BumpPointerAllocatorStatsTest, GetStatsTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    BumpPointerAllocator<MEMORY_POOL_SIZE, true> allocator;
+
+    ASSERT_NE(allocator.Allocate<uint8_t>(1U), nullptr);
+    ASSERT_NE(allocator.Allocate<uint64_t>(2U), nullptr);  // 7 bytes of padding
+    ASSERT_EQ(allocator.Allocate<uint8_t>(0U), nullptr);
+    AllocatorStats stats = allocator.GetStats();
+    ASSERT_EQ(stats.allocations, 2U);
+    ASSERT_EQ(stats.failures, 1U);
+    ASSERT_EQ(stats.liveBytes, 24U);
+    ASSERT_EQ(stats.poolsCount, 1U);
+    ASSERT_EQ(stats.freeBytes, MEMORY_POOL_SIZE - 24U);
+    ASSERT_EQ(stats.largestFreeBlock, stats.freeBytes);
+    ASSERT_EQ(stats.fragmentation, 0.0);
+    ASSERT_GE(stats.reservedBytes, MEMORY_POOL_SIZE);
+
+    // the tail of the first chunk is lost when the second one is mapped
+    ASSERT_NE(allocator.Allocate<uint8_t>(MEMORY_POOL_SIZE), nullptr);
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.poolsCount, 2U);
+    ASSERT_GT(stats.fragmentation, 0.0);
+    ASSERT_GT(stats.reservedBytes, 2U * MEMORY_POOL_SIZE);
+
+    allocator.Free();
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.frees, 1U);
+    ASSERT_EQ(stats.liveBytes, 0U);
+    ASSERT_EQ(stats.poolsCount, 1U);
+}
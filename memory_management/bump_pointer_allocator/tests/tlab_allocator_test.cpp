@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "memory_management/bump_pointer_allocator/include/tlab_allocator.h"
+
+TEST(TlabAllocatorTest, SingleBufferTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    constexpr size_t TLAB_SIZE = 256U;
+    TlabAllocator<MEMORY_POOL_SIZE, TLAB_SIZE> allocator;
+    TlabAllocator<MEMORY_POOL_SIZE, TLAB_SIZE>::ThreadLocalBuffer buffer(allocator);
+
+    auto *first = buffer.Allocate<size_t>(2U);
+    auto *second = buffer.Allocate<size_t>(1U);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(size_t(second) - size_t(first), 2U * sizeof(size_t));  // bump inside one buffer
+    ASSERT_TRUE(allocator.VerifyPtr(first));
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_FALSE(allocator.VerifyPtr(first + 1U));
+
+    auto *big = buffer.Allocate<char>(2U * TLAB_SIZE);  // gets a slice of its own
+    ASSERT_NE(big, nullptr);
+    auto *third = buffer.Allocate<size_t>(1U);
+    ASSERT_EQ(size_t(third) - size_t(second), sizeof(size_t));  // current buffer is still used
+    ASSERT_EQ(buffer.Allocate<char>(MEMORY_POOL_SIZE), nullptr);
+
+    auto *line = buffer.AllocateAligned<char>(1U, CACHE_LINE_SIZE);
+    ASSERT_NE(line, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(line) % CACHE_LINE_SIZE, 0U);
+
+    buffer.Reset();
+    allocator.Free();
+    ASSERT_FALSE(allocator.VerifyPtr(first));
+    ASSERT_EQ(buffer.Allocate<size_t>(2U), first);
+}
+
+TEST(TlabAllocatorTest, ExhaustionTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 256U;
+    constexpr size_t TLAB_SIZE = 128U;
+    TlabAllocator<MEMORY_POOL_SIZE, TLAB_SIZE> allocator;
+    TlabAllocator<MEMORY_POOL_SIZE, TLAB_SIZE>::ThreadLocalBuffer first(allocator);
+    TlabAllocator<MEMORY_POOL_SIZE, TLAB_SIZE>::ThreadLocalBuffer second(allocator);
+
+    ASSERT_NE(first.Allocate<char>(TLAB_SIZE), nullptr);
+    ASSERT_NE(second.Allocate<char>(TLAB_SIZE), nullptr);
+    ASSERT_EQ(first.Allocate<char>(1U), nullptr);
+    ASSERT_EQ(second.Allocate<char>(1U), nullptr);
+}
+
+TEST(TlabAllocatorTest, ConcurrentAllocationTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    constexpr size_t ALLOCS_PER_THREAD = 1000U;
+    constexpr size_t MEMORY_POOL_SIZE = THREADS_COUNT * ALLOCS_PER_THREAD * 2U * sizeof(size_t);
+    TlabAllocator<MEMORY_POOL_SIZE, 512U> allocator;
+
+    std::array<std::vector<size_t *>, THREADS_COUNT> allocated;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            decltype(allocator)::ThreadLocalBuffer buffer(allocator);
+            for (size_t j = 0; j < ALLOCS_PER_THREAD; ++j) {
+                auto *mem = buffer.Allocate<size_t>(1U);
+                ASSERT_NE(mem, nullptr);
+                *mem = i;
+                ptrs.push_back(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<size_t *> all;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        for (auto *mem : allocated[i]) {
+            ASSERT_EQ(*mem, i);  // nobody else wrote here
+            ASSERT_TRUE(allocator.VerifyPtr(mem));
+            all.push_back(mem);
+        }
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
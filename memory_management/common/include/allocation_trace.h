@@ -0,0 +1,251 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATION_TRACE_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATION_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "base/macros.h"
+#include "memory_management/common/include/hooked_allocator.h"
+
+/**
+ * Allocation traces: TracingAllocator records every call of the wrapped allocator to TraceRecorder, which writes
+ * them to a binary file, and ReadTrace() loads them back to be replayed against other allocators.
+ * The file is a TraceHeader followed by TraceEvent records in the byte order of the machine which wrote it.
+ */
+
+enum class TraceEventKind : uint8_t {
+    ALLOCATE,
+    FREE,
+    // Free() of the whole allocator, e.g. of a BumpPointerAllocator, frees all live allocations
+    FREE_ALL,
+};
+
+struct TraceEvent {
+    // nanoseconds since the recorder was opened
+    uint64_t timestampNs;
+    // requested bytes of an allocation, 0 for frees
+    uint64_t size;
+    // allocations get ids 0, 1, 2... in the order they were made, a free has the id of its allocation
+    uint32_t pointerId;
+    // small id of the calling thread, threads get ids in the order they first allocate or free
+    uint16_t threadId;
+    TraceEventKind kind;
+    // log2 of the requested alignment
+    uint8_t alignLog2;
+};
+
+static_assert(sizeof(TraceEvent) == 24U);
+
+struct TraceHeader {
+    static constexpr char MAGIC[8] = {'M', 'M', 'T', 'R', 'A', 'C', 'E', '\0'};  // NOLINT(modernize-avoid-c-arrays)
+    static constexpr uint32_t VERSION = 1U;
+
+    char magic[sizeof(MAGIC)];  // NOLINT(modernize-avoid-c-arrays)
+    uint32_t version;
+    uint32_t eventSize;
+};
+
+/**
+ * @brief Writes events of traced allocators to a file. It is thread safe, so one recorder can serve allocators of
+ * many threads; events are kept in order of calls and written when the buffer is full, by Flush() and at the end
+ */
+class TraceRecorder {
+    // events written at once
+    static constexpr size_t BUFFER_SIZE = 4096U;
+
+public:
+    /**
+     * @brief Creates the file at @param path
+     * @returns the recorder or nullptr if the file can not be written
+     */
+    static std::unique_ptr<TraceRecorder> Open(const char *path)
+    {
+        std::FILE *file = std::fopen(path, "wb");
+        if (file == nullptr) {
+            return nullptr;
+        }
+        TraceHeader header {};
+        std::memcpy(header.magic, TraceHeader::MAGIC, sizeof(TraceHeader::MAGIC));
+        header.version = TraceHeader::VERSION;
+        header.eventSize = sizeof(TraceEvent);
+        if (std::fwrite(&header, sizeof(header), 1U, file) != 1U) {
+            std::fclose(file);
+            return nullptr;
+        }
+        return std::unique_ptr<TraceRecorder>(new TraceRecorder(file));
+    }
+
+    ~TraceRecorder()
+    {
+        Flush();
+        std::fclose(file_);
+    }
+
+    NO_COPY_SEMANTIC(TraceRecorder);
+    NO_MOVE_SEMANTIC(TraceRecorder);
+
+    // records allocation of @param size bytes aligned to @param align at @param ptr, nullptr is not recorded
+    void OnAllocate(const void *ptr, size_t size, size_t align)
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t id = nextId_++;
+        ids_[ptr] = id;
+        Record(TraceEventKind::ALLOCATE, id, size, align);
+    }
+
+    // records free of @param ptr, pointers which were not recorded are ignored
+    void OnFree(const void *ptr)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(ptr);
+        if (it == ids_.end()) {
+            return;
+        }
+        uint32_t id = it->second;
+        ids_.erase(it);
+        Record(TraceEventKind::FREE, id, 0U, 1U);
+    }
+
+    /**
+     * @brief Records free of all live allocations. One recorder should trace only one allocator which can do it,
+     * otherwise allocations of the others are dropped too
+     */
+    void OnFreeAll()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ids_.clear();
+        Record(TraceEventKind::FREE_ALL, 0U, 0U, 1U);
+    }
+
+    // @returns false if the file could not be written
+    bool Flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return FlushLocked();
+    }
+
+    // @returns count of recorded events
+    size_t GetEventsCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return eventsCount_;
+    }
+
+private:
+    explicit TraceRecorder(std::FILE *file) : file_(file), start_(std::chrono::steady_clock::now())
+    {
+        buffer_.reserve(BUFFER_SIZE);
+    }
+
+    static uint16_t ThreadId()
+    {
+        static std::atomic<uint16_t> nextThreadId {0U};
+        thread_local uint16_t id = nextThreadId.fetch_add(1U, std::memory_order_relaxed);
+        return id;
+    }
+
+    static uint8_t Log2(size_t value)
+    {
+        return static_cast<uint8_t>(__builtin_ctzll(value));
+    }
+
+    void Record(TraceEventKind kind, uint32_t id, size_t size, size_t align)
+    {
+        auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        buffer_.push_back(
+            {static_cast<uint64_t>(time.count()), size, id, ThreadId(), kind, Log2(align == 0U ? 1U : align)});
+        ++eventsCount_;
+        if (buffer_.size() == BUFFER_SIZE) {
+            FlushLocked();
+        }
+    }
+
+    bool FlushLocked()
+    {
+        bool written = std::fwrite(buffer_.data(), sizeof(TraceEvent), buffer_.size(), file_) == buffer_.size();
+        buffer_.clear();
+        return std::fflush(file_) == 0 && written;
+    }
+
+    std::mutex mutex_;
+    std::FILE *file_;
+    std::chrono::steady_clock::time_point start_;
+    std::vector<TraceEvent> buffer_;
+    // ids of live allocations
+    std::unordered_map<const void *, uint32_t> ids_;
+    uint32_t nextId_ = 0U;
+    size_t eventsCount_ = 0U;
+};
+
+/**
+ * @brief Reads events of the trace at @param path to @param events
+ * @returns false if the file can not be read or is not a trace
+ */
+inline bool ReadTrace(const char *path, std::vector<TraceEvent> &events)
+{
+    std::FILE *file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    TraceHeader header {};
+    bool valid = std::fread(&header, sizeof(header), 1U, file) == 1U &&
+                 std::memcmp(header.magic, TraceHeader::MAGIC, sizeof(TraceHeader::MAGIC)) == 0 &&
+                 header.version == TraceHeader::VERSION && header.eventSize == sizeof(TraceEvent);
+    events.clear();
+    TraceEvent event {};
+    while (valid && std::fread(&event, sizeof(event), 1U, file) == 1U) {
+        events.push_back(event);
+    }
+    valid &= std::ferror(file) == 0;
+    std::fclose(file);
+    return valid;
+}
+
+// hooks of HookedAllocator which record calls to TraceRecorder
+class TraceHooks {
+public:
+    explicit TraceHooks(TraceRecorder &recorder) : recorder_(&recorder) {}
+
+    void OnAllocate(void *mem, size_t size, size_t align)
+    {
+        recorder_->OnAllocate(mem, size, align);
+    }
+
+    void OnFree(void *ptr)
+    {
+        recorder_->OnFree(ptr);
+    }
+
+    void OnFreeAll()
+    {
+        recorder_->OnFreeAll();
+    }
+
+private:
+    TraceRecorder *recorder_;
+};
+
+/**
+ * @brief HookedAllocator which records calls to TraceRecorder, both Allocator and the recorder should outlive it
+ */
+template <class Allocator>
+class TracingAllocator : public HookedAllocator<Allocator, TraceHooks> {
+public:
+    TracingAllocator(Allocator &allocator, TraceRecorder &recorder)
+        : HookedAllocator<Allocator, TraceHooks>(allocator, TraceHooks(recorder))
+    {
+    }
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATION_TRACE_H
@@ -0,0 +1,72 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_STATS_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_STATS_H
+
+#include <cstddef>
+
+/**
+ * @brief Memory usage of an allocator returned by its GetStats(). GetStats() and all counters exist only if
+ * ALLOCATOR_STATS is defined
+ */
+struct AllocatorStats {
+    // bytes given to live allocations, including rounding up but not headers
+    size_t liveBytes = 0U;
+    // bytes taken from the heap or the OS, including the memory inside the allocator object
+    size_t reservedBytes = 0U;
+    // bytes which are free for new allocations
+    size_t freeBytes = 0U;
+    size_t poolsCount = 0U;
+    // the biggest allocation which can be served from the free bytes
+    size_t largestFreeBlock = 0U;
+    // 1 - largestFreeBlock / freeBytes: 0 means that all free bytes can be allocated at once
+    double fragmentation = 0.0;
+    // successful allocations, batch allocations count every object
+    size_t allocations = 0U;
+    // freed allocations, for bump allocators these are calls to Free() and Rewind()
+    size_t frees = 0U;
+    // allocations which returned nullptr or got fewer objects than requested
+    size_t failures = 0U;
+};
+
+// counters of allocator calls kept by allocators if ALLOCATOR_STATS is defined
+class AllocatorCounters {
+public:
+    void OnAllocate(bool success)
+    {
+        if (success) {
+            ++allocations_;
+        } else {
+            ++failures_;
+        }
+    }
+
+    void OnAllocateBatch(size_t requested, size_t allocated)
+    {
+        allocations_ += allocated;
+        if (allocated != requested) {
+            ++failures_;
+        }
+    }
+
+    void OnFree(size_t count = 1U)
+    {
+        frees_ += count;
+    }
+
+    // fills counters and the fragmentation of @param stats, whose sizes should be already set
+    void Finish(AllocatorStats &stats) const
+    {
+        stats.allocations = allocations_;
+        stats.frees = frees_;
+        stats.failures = failures_;
+        stats.fragmentation = stats.freeBytes == 0U ? 0.0
+                                                    : 1.0 - static_cast<double>(stats.largestFreeBlock) /
+                                                                static_cast<double>(stats.freeBytes);
+    }
+
+private:
+    size_t allocations_ = 0U;
+    size_t frees_ = 0U;
+    size_t failures_ = 0U;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_STATS_H
@@ -0,0 +1,23 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_TRAITS_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_TRAITS_H
+
+#include <type_traits>
+#include <utility>
+
+// true if Allocator can free memory one by one with Free(void *)
+template <class Allocator, class = void>
+constexpr bool CAN_FREE_ONE = false;
+
+template <class Allocator>
+constexpr bool
+    CAN_FREE_ONE<Allocator, std::void_t<decltype(std::declval<Allocator &>().Free(std::declval<void *>()))>> = true;
+
+// true if Allocator can allocate one T with Allocate<T>(), which chooses its size class at compile time
+template <class Allocator, class T, class = void>
+constexpr bool CAN_ALLOCATE_ONE = false;
+
+template <class Allocator, class T>
+constexpr bool
+    CAN_ALLOCATE_ONE<Allocator, T, std::void_t<decltype(std::declval<Allocator &>().template Allocate<T>())>> = true;
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_ALLOCATOR_TRAITS_H
@@ -0,0 +1,315 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_HEAP_PROFILER_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_HEAP_PROFILER_H
+
+#include <execinfo.h>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "base/macros.h"
+#include "memory_management/common/include/hooked_allocator.h"
+
+/**
+ * Sampling heap profiler: allocations are sampled about once per sample period of allocated bytes, every sample
+ * keeps the stack trace of the allocation and its size till it is freed. As in tcmalloc, every thread counts down
+ * bytes till its next sample and the distances between samples are exponentially distributed, so allocations are
+ * sampled with probability proportional to their size and the period does not alias with allocation patterns.
+ * Allocators report calls by ProfiledAllocator or by OnAllocate() and OnFree() directly.
+ * The profiler and the countdowns of threads are plain static data, so an allocation which is not sampled costs a
+ * decrement and one branch. The profiler should not be used by constructors of other static objects.
+ */
+
+// totals of samples with one stack trace
+struct HeapProfileEntry {
+    // return addresses, the innermost frame first
+    std::vector<uintptr_t> stack;
+    // sampled allocations which are not freed yet
+    size_t inuseCount = 0U;
+    size_t inuseBytes = 0U;
+    // all sampled allocations
+    size_t allocCount = 0U;
+    size_t allocBytes = 0U;
+};
+
+class HeapProfiler {
+    // bytes allocated by a thread while sampling is disabled before it checks the period again
+    static constexpr int64_t DISABLED_RECHECK_BYTES = 1 << 20;
+    static constexpr int MAX_STACK_DEPTH = 32;
+    // buckets of the filter which tells frees of sampled allocations from the others
+    static constexpr size_t FILTER_BITS = 12U;
+    static constexpr size_t FILTER_SIZE = size_t {1U} << FILTER_BITS;
+
+public:
+    static constexpr size_t DEFAULT_SAMPLE_PERIOD = 512U * 1024U;
+
+    // the profiler of the process
+    static HeapProfiler &Instance()
+    {
+        return instance_;
+    }
+
+    ~HeapProfiler() = default;
+    NO_COPY_SEMANTIC(HeapProfiler);
+    NO_MOVE_SEMANTIC(HeapProfiler);
+
+    /**
+     * @brief Samples once per @param bytes allocated on average, 0 disables sampling. The calling thread starts a new
+     * countdown at once, other threads use the new period after their current countdown runs out
+     */
+    void SetSamplePeriod(size_t bytes)
+    {
+        period_.store(bytes, std::memory_order_relaxed);
+        sampler_.bytesUntilSample = NextSampleDistance(sampler_);
+    }
+
+    size_t GetSamplePeriod() const
+    {
+        return period_.load(std::memory_order_relaxed);
+    }
+
+    // should be called after @param size bytes are allocated at @param ptr, nullptr is never sampled
+    ALWAYS_INLINE void OnAllocate(void *ptr, size_t size)
+    {
+        sampler_.bytesUntilSample -= static_cast<int64_t>(size);
+        if (UNLIKELY(sampler_.bytesUntilSample < 0)) {
+            Sample(sampler_, ptr, size);
+        }
+    }
+
+    // should be called before @param ptr is freed
+    ALWAYS_INLINE void OnFree(void *ptr)
+    {
+        // sampled allocations are rare, so most frees only check the filter
+        if (UNLIKELY(filter_[FilterBucket(ptr)].load(std::memory_order_relaxed) != 0U)) {
+            RemoveSample(ptr);
+        }
+    }
+
+    // @returns totals of samples grouped by stack traces
+    std::vector<HeapProfileEntry> GetProfile()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<HeapProfileEntry> profile;
+        profile.reserve(stacks_.size());
+        for (const auto &[stack, entry] : stacks_) {
+            profile.push_back(entry);
+        }
+        return profile;
+    }
+
+    /**
+     * @brief Writes the profile to @param path in the legacy heap format of gperftools which pprof reads, e.g.
+     * pprof --text <binary> <path>. Counts are of samples, pprof scales them by the sample period of the header.
+     * @returns false if the file can not be written
+     */
+    bool WriteProfile(const char *path)
+    {
+        std::FILE *file = std::fopen(path, "w");
+        if (file == nullptr) {
+            return false;
+        }
+        std::vector<HeapProfileEntry> profile = GetProfile();
+        HeapProfileEntry total;
+        for (const HeapProfileEntry &entry : profile) {
+            total.inuseCount += entry.inuseCount;
+            total.inuseBytes += entry.inuseBytes;
+            total.allocCount += entry.allocCount;
+            total.allocBytes += entry.allocBytes;
+        }
+        std::fprintf(file, "heap profile: %zu: %zu [%zu: %zu] @ heap_v2/%zu\n", total.inuseCount, total.inuseBytes,
+                     total.allocCount, total.allocBytes, GetSamplePeriod());
+        for (const HeapProfileEntry &entry : profile) {
+            std::fprintf(file, "%zu: %zu [%zu: %zu] @", entry.inuseCount, entry.inuseBytes, entry.allocCount,
+                         entry.allocBytes);
+            for (uintptr_t address : entry.stack) {
+                std::fprintf(file, " %#zx", static_cast<size_t>(address));
+            }
+            std::fputc('\n', file);
+        }
+        // pprof needs the mappings to symbolize addresses
+        std::fputs("\nMAPPED_LIBRARIES:\n", file);
+        if (std::FILE *maps = std::fopen("/proc/self/maps", "r"); maps != nullptr) {
+            for (int c = std::fgetc(maps); c != EOF; c = std::fgetc(maps)) {
+                std::fputc(c, file);
+            }
+            std::fclose(maps);
+        }
+        bool written = std::ferror(file) == 0;
+        return std::fclose(file) == 0 && written;
+    }
+
+    // drops all samples, e.g. to start a new profile
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &[ptr, sample] : samples_) {
+            filter_[FilterBucket(ptr)].fetch_sub(1U, std::memory_order_relaxed);
+        }
+        samples_.clear();
+        stacks_.clear();
+    }
+
+private:
+    using Stack = std::vector<uintptr_t>;
+
+    // trivial, so the thread local needs no initialization on access
+    struct Sampler {
+        // the allocation which makes it negative is sampled
+        int64_t bytesUntilSample;
+        // state of xorshift64*, 0 till the first sample of the thread seeds it
+        uint64_t random;
+    };
+
+    struct SampledAllocation {
+        HeapProfileEntry *entry;
+        size_t size;
+    };
+
+    HeapProfiler() = default;
+
+    static size_t FilterBucket(const void *ptr)
+    {
+        constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+        constexpr size_t SHIFT = 64U - FILTER_BITS;
+        return static_cast<size_t>((reinterpret_cast<uintptr_t>(ptr) * MULTIPLIER) >> SHIFT);
+    }
+
+    static void Seed(Sampler &sampler)
+    {
+        std::random_device device;
+        // xorshift gets stuck at 0
+        do {
+            sampler.random = (uint64_t {device()} << 32U) ^ device();
+        } while (sampler.random == 0U);
+    }
+
+    int64_t NextSampleDistance(Sampler &sampler)
+    {
+        if (sampler.random == 0U) {
+            Seed(sampler);
+        }
+        size_t period = GetSamplePeriod();
+        if (period == 0U) {
+            return DISABLED_RECHECK_BYTES;
+        }
+        constexpr uint64_t MULTIPLIER = 0x2545F4914F6CDD1DULL;
+        constexpr unsigned MANTISSA_BITS = 53U;
+        sampler.random ^= sampler.random >> 12U;
+        sampler.random ^= sampler.random << 25U;
+        sampler.random ^= sampler.random >> 27U;
+        uint64_t bits = (sampler.random * MULTIPLIER) >> (64U - MANTISSA_BITS);
+        // uniform in (0, 1], so the logarithm is finite
+        double uniform = static_cast<double>(bits + 1U) / static_cast<double>(uint64_t {1U} << MANTISSA_BITS);
+        return static_cast<int64_t>(-std::log(uniform) * static_cast<double>(period));
+    }
+
+    NO_INLINE void Sample(Sampler &sampler, void *ptr, size_t size)
+    {
+        if (sampler.random == 0U) {
+            // the first countdown of the thread picks its distance, the allocation is sampled only if it crosses it
+            sampler.bytesUntilSample += NextSampleDistance(sampler);
+            if (sampler.bytesUntilSample >= 0) {
+                return;
+            }
+        }
+        // an allocation bigger than a few distances is still sampled once
+        sampler.bytesUntilSample = NextSampleDistance(sampler);
+        if (ptr == nullptr || GetSamplePeriod() == 0U) {
+            return;
+        }
+        void *frames[MAX_STACK_DEPTH];  // NOLINT(modernize-avoid-c-arrays)
+        int depth = backtrace(frames, MAX_STACK_DEPTH);
+        // the frame of this function is not a part of the profile
+        Stack stack;
+        for (int i = 1; i < depth; ++i) {
+            stack.push_back(reinterpret_cast<uintptr_t>(frames[i]));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        HeapProfileEntry &entry = stacks_[stack];
+        if (entry.stack.empty()) {
+            entry.stack = std::move(stack);
+        }
+        ++entry.inuseCount;
+        entry.inuseBytes += size;
+        ++entry.allocCount;
+        entry.allocBytes += size;
+        auto [it, inserted] = samples_.try_emplace(ptr, SampledAllocation {&entry, size});
+        if (inserted) {
+            filter_[FilterBucket(ptr)].fetch_add(1U, std::memory_order_relaxed);
+        } else {
+            // the address is reused without OnFree(), e.g. after Free() of the whole allocator
+            Retire(it->second);
+            it->second = {&entry, size};
+        }
+    }
+
+    // the sampled allocation is not in use anymore
+    static void Retire(const SampledAllocation &sample)
+    {
+        --sample.entry->inuseCount;
+        sample.entry->inuseBytes -= sample.size;
+    }
+
+    NO_INLINE void RemoveSample(void *ptr)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = samples_.find(ptr);
+        if (it == samples_.end()) {
+            return;
+        }
+        Retire(it->second);
+        samples_.erase(it);
+        filter_[FilterBucket(ptr)].fetch_sub(1U, std::memory_order_relaxed);
+    }
+
+    static HeapProfiler instance_;
+    inline static thread_local Sampler sampler_ {};
+
+    std::atomic<size_t> period_ {DEFAULT_SAMPLE_PERIOD};
+    // count of live samples in every bucket, changed under the mutex
+    std::atomic<uint32_t> filter_[FILTER_SIZE] {};  // NOLINT(modernize-avoid-c-arrays)
+    std::mutex mutex_;
+    // nodes of std::map are stable, so samples refer to their entries
+    std::map<Stack, HeapProfileEntry> stacks_;
+    std::unordered_map<void *, SampledAllocation> samples_;
+};
+
+inline HeapProfiler HeapProfiler::instance_;
+
+// hooks of HookedAllocator which report calls to HeapProfiler::Instance()
+class HeapProfilerHooks {
+public:
+    void OnAllocate(void *mem, size_t size, [[maybe_unused]] size_t align)
+    {
+        HeapProfiler::Instance().OnAllocate(mem, size);
+    }
+
+    void OnFree(void *ptr)
+    {
+        HeapProfiler::Instance().OnFree(ptr);
+    }
+
+    // samples of allocations freed at once stay in use till their addresses are sampled again
+    void OnFreeAll() {}
+};
+
+/**
+ * @brief HookedAllocator which reports calls to HeapProfiler::Instance(), Allocator should outlive it
+ */
+template <class Allocator>
+class ProfiledAllocator : public HookedAllocator<Allocator, HeapProfilerHooks> {
+public:
+    explicit ProfiledAllocator(Allocator &allocator)
+        : HookedAllocator<Allocator, HeapProfilerHooks>(allocator, HeapProfilerHooks {})
+    {
+    }
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_HEAP_PROFILER_H
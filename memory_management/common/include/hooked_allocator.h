@@ -0,0 +1,71 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_HOOKED_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_HOOKED_ALLOCATOR_H
+
+#include <cstddef>
+#include <utility>
+#include "base/macros.h"
+
+/**
+ * @brief Allocator which forwards calls to Allocator and reports them to Hooks. It has the same methods as Allocator,
+ * e.g. Free(void *) only if Allocator can free memory one by one. Allocator should outlive it. Hooks provides:
+ *   void OnAllocate(void *mem, size_t size, size_t align) - after an allocation, @param mem is nullptr if it failed
+ *   void OnFree(void *ptr) - before @param ptr is freed, so another thread can not get it from the allocator yet
+ *   void OnFreeAll() - before all memory of the allocator is freed at once
+ */
+template <class Allocator, class Hooks>
+class HookedAllocator {
+public:
+    HookedAllocator(Allocator &allocator, Hooks hooks) : allocator_(allocator), hooks_(std::move(hooks)) {}
+    ~HookedAllocator() = default;
+    NO_COPY_SEMANTIC(HookedAllocator);
+    NO_MOVE_SEMANTIC(HookedAllocator);
+
+    template <class T, class A = Allocator>
+    auto Allocate() -> decltype(std::declval<A &>().template Allocate<T>())
+    {
+        T *mem = allocator_.template Allocate<T>();
+        hooks_.OnAllocate(mem, sizeof(T), alignof(T));
+        return mem;
+    }
+
+    template <class T, class A = Allocator>
+    auto Allocate(size_t count) -> decltype(std::declval<A &>().template Allocate<T>(count))
+    {
+        T *mem = allocator_.template Allocate<T>(count);
+        hooks_.OnAllocate(mem, count * sizeof(T), alignof(T));
+        return mem;
+    }
+
+    template <class T>
+    T *AllocateAligned(size_t count, size_t align)
+    {
+        T *mem = allocator_.template AllocateAligned<T>(count, align);
+        hooks_.OnAllocate(mem, count * sizeof(T), align);
+        return mem;
+    }
+
+    template <class A = Allocator>
+    auto Free(void *ptr) -> decltype(std::declval<A &>().Free(ptr))
+    {
+        hooks_.OnFree(ptr);
+        allocator_.Free(ptr);
+    }
+
+    template <class A = Allocator>
+    auto Free() -> decltype(std::declval<A &>().Free())
+    {
+        hooks_.OnFreeAll();
+        allocator_.Free();
+    }
+
+    Allocator &GetAllocator()
+    {
+        return allocator_;
+    }
+
+private:
+    Allocator &allocator_;
+    Hooks hooks_;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_HOOKED_ALLOCATOR_H
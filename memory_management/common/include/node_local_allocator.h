@@ -0,0 +1,134 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_NODE_LOCAL_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_NODE_LOCAL_ALLOCATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include "base/alignment.h"
+#include "base/macros.h"
+#include "memory_management/common/include/numa.h"
+
+/**
+ * @brief Thread safe front end keeping one Allocator per NUMA node. Allocator should take NumaPageSource
+ * (e.g. FreeListAllocator<SIZE, NumaPageSource>), so pools of every node allocator are placed on its node.
+ * Memory is allocated from the node of the calling thread, other nodes are tried only if it is out of memory.
+ * Allocator should provide static OwnerOf(ptr), which finds the allocator of live memory by its pool header.
+ * Nodes above MAX_NODES_COUNT share allocators with lower ones
+ */
+template <class Allocator, size_t MAX_NODES_COUNT = 8U>
+class NodeLocalAllocator {
+    static_assert(MAX_NODES_COUNT != 0U, "there should be at least one node");
+
+public:
+    NodeLocalAllocator() : nodes_(MakeNodes(std::make_index_sequence<MAX_NODES_COUNT>())) {}
+    ~NodeLocalAllocator() = default;
+    NO_COPY_SEMANTIC(NodeLocalAllocator);
+    NO_MOVE_SEMANTIC(NodeLocalAllocator);
+
+    /**
+     * @brief Allocates memory of the calling thread node by Allocator::Allocate<T>(@param args)
+     */
+    template <class T = uint8_t, class... Args>
+    T *Allocate(Args... args)
+    {
+        size_t local = LocalNode();
+        for (size_t i = 0; i < NodesCount(); ++i) {
+            Node &node = nodes_[(local + i) % NodesCount()];
+            std::lock_guard<std::mutex> lock(node.mutex);
+            T *mem = node.allocator.template Allocate<T>(args...);
+            if (LIKELY(mem != nullptr)) {
+                return mem;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Frees @param ptr allocated by any thread. The owner node is found in O(1) by Allocator::OwnerOf(),
+     * so only its lock is taken
+     */
+    void Free(void *ptr)
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        Node &node = NodeOf(ptr);
+        std::lock_guard<std::mutex> lock(node.mutex);
+        node.allocator.Free(ptr);
+    }
+
+    /**
+     * @brief Method should check in @param ptr is pointer to mem from this allocator
+     * @returns true if ptr is from this allocator
+     */
+    bool VerifyPtr(void *ptr)
+    {
+        for (size_t i = 0; i < NodesCount(); ++i) {
+            std::lock_guard<std::mutex> lock(nodes_[i].mutex);
+            if (nodes_[i].allocator.VerifyPtr(ptr)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gives empty pools of all nodes back
+     * @returns count of released pools
+     */
+    size_t Trim()
+    {
+        size_t released = 0U;
+        for (size_t i = 0; i < NodesCount(); ++i) {
+            std::lock_guard<std::mutex> lock(nodes_[i].mutex);
+            released += nodes_[i].allocator.Trim();
+        }
+        return released;
+    }
+
+    // @returns allocator of NUMA node @param node, it should be used under no concurrent access
+    Allocator &GetNodeAllocator(size_t node)
+    {
+        return nodes_[node % NodesCount()].allocator;
+    }
+
+    static size_t NodesCount()
+    {
+        return NumaNodesCount() < MAX_NODES_COUNT ? NumaNodesCount() : MAX_NODES_COUNT;
+    }
+
+private:
+    // every node is on its own cache lines, so threads of different nodes do not interfere
+    struct alignas(CACHE_LINE_SIZE) Node {
+        explicit Node(size_t node) : allocator(NumaPageSource(node)) {}
+
+        std::mutex mutex;
+        Allocator allocator;
+    };
+
+    template <size_t... NODES>
+    static std::array<Node, MAX_NODES_COUNT> MakeNodes(std::index_sequence<NODES...> /* unused */)
+    {
+        return {Node(NODES)...};
+    }
+
+    // live memory keeps its pool, so the pool header is read without any lock
+    Node &NodeOf(const void *ptr)
+    {
+        // nodes are in one array, so the distance between their allocators is a multiple of the node size
+        auto owner = reinterpret_cast<uintptr_t>(Allocator::OwnerOf(ptr));
+        auto first = reinterpret_cast<uintptr_t>(&nodes_[0].allocator);
+        return nodes_[(owner - first) / sizeof(Node)];
+    }
+
+    static size_t LocalNode()
+    {
+        return CurrentNumaNode() % NodesCount();
+    }
+
+    std::array<Node, MAX_NODES_COUNT> nodes_;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_NODE_LOCAL_ALLOCATOR_H
@@ -0,0 +1,92 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_NUMA_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_NUMA_H
+
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include "base/alignment.h"
+#include "memory_management/common/include/os_pages.h"
+#include "memory_management/common/include/page_source.h"
+
+// @returns count of NUMA nodes of the machine, 1 if the system has no NUMA support
+inline size_t NumaNodesCount()
+{
+    static const size_t NODES_COUNT = [] {
+        // the file holds a list of node ranges like "0-1" or "0,2-3", the last number is the biggest node
+        std::FILE *file = std::fopen("/sys/devices/system/node/possible", "r");
+        if (file == nullptr) {
+            return size_t {1U};
+        }
+        size_t last = 0U;
+        size_t number = 0U;
+        for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file)) {
+            if (c >= '0' && c <= '9') {
+                number = number * 10U + static_cast<size_t>(c - '0');
+            } else if (c == ',' || c == '-') {
+                number = 0U;
+            } else {
+                break;
+            }
+            last = number;
+        }
+        std::fclose(file);
+        return last + 1U;
+    }();
+    return NODES_COUNT;
+}
+
+// @returns NUMA node of the CPU the calling thread runs on, 0 if it is unknown
+inline size_t CurrentNumaNode()
+{
+    unsigned cpu = 0U;
+    unsigned node = 0U;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0U;
+    }
+    return node;
+}
+
+/**
+ * @brief Maps pages with anonymous mmap and binds them to NUMA node NODE before the first touch by mbind.
+ * The policy is preferred, so the memory still comes from other nodes when the node is out of memory.
+ * Binding is a hint: memory is given even if the kernel has no NUMA support
+ */
+class NumaPageSource {
+    // from linux/mempolicy.h, which is not always installed
+    static constexpr int MPOL_PREFERRED = 1;
+    static constexpr size_t BITS_IN_WORD = 64U;
+
+public:
+    static constexpr size_t ANY_NODE = SIZE_MAX;
+
+    NumaPageSource() = default;
+    explicit NumaPageSource(size_t node) : node_(node) {}
+
+    size_t GetNode() const
+    {
+        return node_;
+    }
+
+    void *Map(size_t size, size_t align)
+    {
+        size = AlignUp(size, PageSize());
+        void *mem = MapAlignedPages(size, align);
+        if (mem != nullptr && node_ < BITS_IN_WORD) {
+            uint64_t nodeMask = uint64_t {1U} << node_;
+            syscall(SYS_mbind, mem, size, MPOL_PREFERRED, &nodeMask, BITS_IN_WORD, 0U);
+        }
+        return mem;
+    }
+
+    void Unmap(void *mem, size_t size, [[maybe_unused]] size_t align)
+    {
+        munmap(mem, AlignUp(size, PageSize()));
+    }
+
+private:
+    size_t node_ = ANY_NODE;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_NUMA_H
@@ -0,0 +1,30 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_OS_PAGES_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_OS_PAGES_H
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include "base/alignment.h"
+
+// @returns size of a virtual memory page
+inline size_t PageSize()
+{
+    static const auto PAGE_SIZE = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return PAGE_SIZE;
+}
+
+/**
+ * @brief Gives physical memory of pages lying entirely inside [@param mem, @param mem + @param size) back to the OS.
+ * The range stays mapped and reads as zeros on the next touch, so it is safe for memory owned by anyone
+ */
+inline void ReleasePages(void *mem, size_t size)
+{
+    auto begin = AlignUp(reinterpret_cast<uintptr_t>(mem), PageSize());
+    auto end = AlignDown(reinterpret_cast<uintptr_t>(mem) + size, PageSize());
+    if (begin < end) {
+        madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+    }
+}
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_OS_PAGES_H
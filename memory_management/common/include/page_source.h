@@ -0,0 +1,223 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_PAGE_SOURCE_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_PAGE_SOURCE_H
+
+#include <sys/mman.h>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "base/alignment.h"
+#include "memory_management/common/include/os_pages.h"
+
+/**
+ * Page sources give memory for pools and chunks of the allocators. Every source provides two methods:
+ *   void *Map(size_t size, size_t align) - @returns @param size bytes aligned to @param align, which is a power
+ *       of two, or nullptr if there is no memory. The memory is not guaranteed to be zeroed
+ *   void Unmap(void *mem, size_t size, size_t align) - gives back memory returned by Map() for the same size and align
+ * Sources are not thread safe, every allocator keeps its own one.
+ */
+
+// Takes memory from the heap through aligned operator new
+class NewPageSource {
+public:
+    void *Map(size_t size, size_t align)
+    {
+        return ::operator new(size, std::align_val_t {align}, std::nothrow);
+    }
+
+    void Unmap(void *mem, [[maybe_unused]] size_t size, size_t align)
+    {
+        ::operator delete(mem, std::align_val_t {align});
+    }
+};
+
+/**
+ * @brief Maps @param size bytes aligned to @param align with anonymous mmap, @param size should be a multiple of
+ * the page size. Alignment bigger than a page is got by mapping more and unmapping the excess around
+ * @returns mapped memory or nullptr
+ */
+inline void *MapAlignedPages(size_t size, size_t align, int flags = 0)
+{
+    size_t padding = align > PageSize() ? align - PageSize() : 0U;
+    if (size > SIZE_MAX - padding) {
+        return nullptr;
+    }
+    void *mem = mmap(nullptr, size + padding, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    if (mem == MAP_FAILED) {
+        return nullptr;
+    }
+    auto begin = reinterpret_cast<uintptr_t>(mem);
+    auto aligned = AlignUp(begin, align);
+    if (aligned != begin) {
+        munmap(mem, aligned - begin);
+    }
+    if (aligned + size != begin + size + padding) {
+        munmap(reinterpret_cast<void *>(aligned + size), begin + padding - aligned);
+    }
+    return reinterpret_cast<void *>(aligned);
+}
+
+// Maps memory from the OS with anonymous mmap, sizes are rounded up to the page size
+class MmapPageSource {
+public:
+    void *Map(size_t size, size_t align)
+    {
+        return MapAlignedPages(AlignUp(size, PageSize()), align);
+    }
+
+    void Unmap(void *mem, size_t size, [[maybe_unused]] size_t align)
+    {
+        munmap(mem, AlignUp(size, PageSize()));
+    }
+};
+
+/**
+ * @brief Maps memory backed by 2MB pages, sizes are rounded up to HUGE_PAGE_SIZE. Reserved huge pages (MAP_HUGETLB)
+ * are tried first. If there are none, the memory is mapped aligned to HUGE_PAGE_SIZE and advised for transparent
+ * huge pages, so it is still backed by huge pages when the kernel allows it
+ */
+class HugePageSource {
+public:
+    static constexpr size_t HUGE_PAGE_SHIFT = 21U;
+    static constexpr size_t HUGE_PAGE_SIZE = size_t {1U} << HUGE_PAGE_SHIFT;
+
+    void *Map(size_t size, size_t align)
+    {
+        if (size > SIZE_MAX - HUGE_PAGE_SIZE) {
+            return nullptr;
+        }
+        size = AlignUp(size, HUGE_PAGE_SIZE);
+        // huge pages are aligned to their size, bigger alignment is left to the transparent huge pages
+        if (align <= HUGE_PAGE_SIZE) {
+            constexpr int HUGETLB_FLAGS = MAP_HUGETLB | static_cast<int>(HUGE_PAGE_SHIFT << MAP_HUGE_SHIFT);
+            void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | HUGETLB_FLAGS, -1, 0);
+            if (mem != MAP_FAILED) {
+                return mem;
+            }
+        }
+        void *mem = MapAlignedPages(size, align < HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : align);
+        if (mem != nullptr) {
+            madvise(mem, size, MADV_HUGEPAGE);
+        }
+        return mem;
+    }
+
+    void Unmap(void *mem, size_t size, [[maybe_unused]] size_t align)
+    {
+        munmap(mem, AlignUp(size, HUGE_PAGE_SIZE));
+    }
+};
+
+/**
+ * @brief Cuts memory from the caller supplied buffer, e.g. placed in shared memory. The buffer is not owned by
+ * the source and should outlive the allocator. Free memory below the top of the buffer, i.e. unmapped memory and
+ * alignment padding, is kept in an intrusive list sorted by address. Neighbouring free ranges are merged and a range
+ * reaching the top is given back to the buffer, Map() takes the first range which fits with the alignment.
+ * Sizes are rounded up to the list node size, so every free range can hold its node and no memory is lost
+ */
+class BufferPageSource {
+public:
+    BufferPageSource() = default;
+    BufferPageSource(void *buffer, size_t size)
+        : top_(AlignUp(reinterpret_cast<uintptr_t>(buffer), GRANULE)),
+          end_(AlignDown(reinterpret_cast<uintptr_t>(buffer) + size, GRANULE))
+    {
+        end_ = end_ < top_ ? top_ : end_;
+    }
+
+    void *Map(size_t size, size_t align)
+    {
+        if (size > SIZE_MAX - GRANULE) {
+            return nullptr;
+        }
+        size = AlignUp(size, GRANULE);
+        for (FreeRange **link = &freeRanges_; *link != nullptr; link = &(*link)->next) {
+            FreeRange *range = *link;
+            uintptr_t rangeBegin = BeginOf(range);
+            uintptr_t rangeEnd = EndOf(range);
+            uintptr_t begin = AlignUp(rangeBegin, align);
+            if (begin >= rangeBegin && begin <= rangeEnd && size <= rangeEnd - begin) {
+                *link = range->next;
+                // the padding before the memory and the tail after it stay free
+                Release(rangeBegin, begin);
+                Release(begin + size, rangeEnd);
+                return reinterpret_cast<void *>(begin);
+            }
+        }
+        uintptr_t begin = AlignUp(top_, align);
+        if (begin < top_ || begin > end_ || size > end_ - begin) {
+            return nullptr;
+        }
+        uintptr_t padding = top_;
+        top_ = begin + size;
+        Release(padding, begin);
+        return reinterpret_cast<void *>(begin);
+    }
+
+    void Unmap(void *mem, size_t size, [[maybe_unused]] size_t align)
+    {
+        auto begin = reinterpret_cast<uintptr_t>(mem);
+        Release(begin, begin + AlignUp(size, GRANULE));
+    }
+
+private:
+    struct FreeRange {
+        FreeRange *next;
+        size_t size;
+    };
+
+    // bounds of all ranges are multiples of it, so any free range can hold its node
+    static constexpr size_t GRANULE = sizeof(FreeRange);
+    static_assert(IsPowerOfTwo(GRANULE), "sizes are aligned up to the granule");
+
+    static uintptr_t BeginOf(const FreeRange *range)
+    {
+        return reinterpret_cast<uintptr_t>(range);
+    }
+
+    static uintptr_t EndOf(const FreeRange *range)
+    {
+        return BeginOf(range) + range->size;
+    }
+
+    // puts [@param begin, @param end) to the list, merging it with its neighbours and with the top
+    void Release(uintptr_t begin, uintptr_t end)
+    {
+        if (begin >= end) {
+            return;
+        }
+        FreeRange **prevLink = nullptr;
+        FreeRange **link = &freeRanges_;
+        while (*link != nullptr && BeginOf(*link) < begin) {
+            prevLink = link;
+            link = &(*link)->next;
+        }
+        FreeRange *next = *link;
+        FreeRange *range = nullptr;
+        if (prevLink != nullptr && EndOf(*prevLink) == begin) {
+            range = *prevLink;
+            range->size += end - begin;
+            link = prevLink;
+        } else if (end == top_) {
+            top_ = begin;
+            return;
+        } else {
+            range = new (reinterpret_cast<void *>(begin)) FreeRange {next, end - begin};
+            *link = range;
+        }
+        if (next != nullptr && EndOf(range) == BeginOf(next)) {
+            range->size += next->size;
+            range->next = next->next;
+        }
+        // the last range may reach the top after the merge
+        if (range->next == nullptr && EndOf(range) == top_) {
+            top_ = BeginOf(range);
+            *link = nullptr;
+        }
+    }
+
+    uintptr_t top_ = 0U;
+    uintptr_t end_ = 0U;
+    FreeRange *freeRanges_ = nullptr;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_PAGE_SOURCE_H
@@ -0,0 +1,138 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_POOL_MAP_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_POOL_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "base/alignment.h"
+#include "base/macros.h"
+
+/**
+ * @brief Set of base addresses of pools which are aligned to the same power of two. It tells in O(1) if masking
+ * a pointer down to the pool alignment lands on a pool, before the pool header at that address is read.
+ * Open addressing with linear probing; the table is a raw array which grows twice when it is half full.
+ */
+class PoolMap {
+    static constexpr size_t MIN_CAPACITY = 16U;
+    static constexpr size_t BITS_IN_HASH = 64U;
+    static constexpr uintptr_t EMPTY = 0U;
+
+public:
+    explicit PoolMap(size_t poolAlign) : poolMask_(~(poolAlign - 1U))
+    {
+        assert(IsPowerOfTwo(poolAlign));
+    }
+    ~PoolMap()
+    {
+        delete[] table_;
+    }
+    NO_COPY_SEMANTIC(PoolMap);
+    NO_MOVE_SEMANTIC(PoolMap);
+
+    uintptr_t PoolBaseOf(const void *ptr) const
+    {
+        return reinterpret_cast<uintptr_t>(ptr) & poolMask_;
+    }
+
+    // @returns false if there is no memory for the table
+    bool Insert(uintptr_t base)
+    {
+        if (UNLIKELY(2U * (size_ + 1U) > capacity_) && !Rehash(capacity_ == 0U ? MIN_CAPACITY : 2U * capacity_)) {
+            return false;
+        }
+        size_t idx = Slot(base);
+        while (table_[idx] != EMPTY) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            idx = (idx + 1U) & (capacity_ - 1U);
+        }
+        table_[idx] = base;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        ++size_;
+        return true;
+    }
+
+    void Erase(uintptr_t base)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size_t idx = Find(base);
+        if (idx == capacity_) {
+            return;
+        }
+        // backward shift deletion keeps probe sequences without holes
+        size_t next = (idx + 1U) & (capacity_ - 1U);
+        while (table_[next] != EMPTY) {
+            size_t home = Slot(table_[next]);
+            // entry at next may move to idx if idx is between its home slot and next in probe order
+            if (((next - home) & (capacity_ - 1U)) >= ((next - idx) & (capacity_ - 1U))) {
+                table_[idx] = table_[next];
+                idx = next;
+            }
+            next = (next + 1U) & (capacity_ - 1U);
+        }
+        table_[idx] = EMPTY;
+        --size_;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    bool Contains(uintptr_t base) const
+    {
+        return Find(base) != capacity_;
+    }
+
+    // @returns true if @param ptr is inside one of the pools
+    bool ContainsPoolOf(const void *ptr) const
+    {
+        return Contains(PoolBaseOf(ptr));
+    }
+
+private:
+    size_t Slot(uintptr_t base) const
+    {
+        // Fibonacci hashing takes the high bits of the product, so zero low bits of aligned bases do not matter
+        constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>((base * MULTIPLIER) >> (BITS_IN_HASH - capacityShift_));
+    }
+
+    // @returns index of @param base in the table or capacity_
+    size_t Find(uintptr_t base) const
+    {
+        if (capacity_ == 0U || base == EMPTY) {
+            return capacity_;
+        }
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (size_t idx = Slot(base); table_[idx] != EMPTY; idx = (idx + 1U) & (capacity_ - 1U)) {
+            if (table_[idx] == base) {
+                return idx;
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return capacity_;
+    }
+
+    bool Rehash(size_t capacity)
+    {
+        auto *table = new (std::nothrow) uintptr_t[capacity]();
+        if (table == nullptr) {
+            return false;
+        }
+        uintptr_t *old = table_;
+        size_t oldCapacity = capacity_;
+        table_ = table;
+        capacity_ = capacity;
+        capacityShift_ = static_cast<size_t>(__builtin_ctzll(capacity));
+        size_ = 0U;
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (old[i] != EMPTY) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                Insert(old[i]);     // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+        delete[] old;
+        return true;
+    }
+
+    uintptr_t poolMask_;
+    uintptr_t *table_ = nullptr;
+    size_t capacity_ = 0U;
+    size_t capacityShift_ = 0U;
+    size_t size_ = 0U;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_POOL_MAP_H
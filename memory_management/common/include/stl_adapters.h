@@ -0,0 +1,115 @@
+#ifndef MEMORY_MANAGEMENT_COMMON_INCLUDE_STL_ADAPTERS_H
+#define MEMORY_MANAGEMENT_COMMON_INCLUDE_STL_ADAPTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include "base/macros.h"
+#include "memory_management/common/include/allocator_traits.h"
+
+/**
+ * Adapters letting STL containers use the allocators of this project. Allocator should provide
+ * AllocateAligned<T>(count, align) and, if memory can be freed one by one, Free(void *). Allocators without
+ * Free(void *), like BumpPointerAllocator, are monotonic: deallocation does nothing, memory is given back with
+ * the allocator itself. Adapters only refer to the allocator, which should outlive them, and are not thread safe.
+ * As STL requires, they throw std::bad_alloc when the allocator is out of memory.
+ */
+
+/**
+ * @brief std::pmr::memory_resource over Allocator, e.g. for std::pmr::vector or std::pmr::unordered_map
+ */
+template <class Allocator>
+class AllocatorMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit AllocatorMemoryResource(Allocator &allocator) : allocator_(allocator) {}
+    ~AllocatorMemoryResource() override = default;
+    NO_COPY_SEMANTIC(AllocatorMemoryResource);
+    NO_MOVE_SEMANTIC(AllocatorMemoryResource);
+
+    Allocator &GetAllocator() const
+    {
+        return allocator_;
+    }
+
+private:
+    void *do_allocate(size_t bytes, size_t align) override
+    {
+        // STL may ask for zero bytes, it should still get a unique pointer
+        void *mem = allocator_.template AllocateAligned<uint8_t>(bytes == 0U ? 1U : bytes, align);
+        if (mem == nullptr) {
+            throw std::bad_alloc();
+        }
+        return mem;
+    }
+
+    void do_deallocate(void *ptr, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t align) override
+    {
+        if constexpr (CAN_FREE_ONE<Allocator>) {
+            allocator_.Free(ptr);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    Allocator &allocator_;
+};
+
+/**
+ * @brief C++17 Allocator over Allocator for containers with a custom allocator type.
+ * Copies and rebound copies refer to the same allocator and compare equal
+ */
+template <class T, class Allocator>
+class StlAllocator {
+public:
+    using value_type = T;
+
+    explicit StlAllocator(Allocator &allocator) noexcept : allocator_(&allocator) {}
+
+    template <class U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    StlAllocator(const StlAllocator<U, Allocator> &other) noexcept : allocator_(&other.GetAllocator())
+    {
+    }
+
+    T *allocate(size_t count)
+    {
+        T *mem = allocator_->template AllocateAligned<T>(count, alignof(T));
+        if (mem == nullptr) {
+            throw std::bad_alloc();
+        }
+        return mem;
+    }
+
+    void deallocate(T *ptr, [[maybe_unused]] size_t count) noexcept
+    {
+        if constexpr (CAN_FREE_ONE<Allocator>) {
+            allocator_->Free(ptr);
+        }
+    }
+
+    Allocator &GetAllocator() const noexcept
+    {
+        return *allocator_;
+    }
+
+    template <class U>
+    bool operator==(const StlAllocator<U, Allocator> &other) const noexcept
+    {
+        return allocator_ == &other.GetAllocator();
+    }
+
+    template <class U>
+    bool operator!=(const StlAllocator<U, Allocator> &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    Allocator *allocator_;
+};
+
+#endif  // MEMORY_MANAGEMENT_COMMON_INCLUDE_STL_ADAPTERS_H
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+#include "memory_management/common/include/allocation_trace.h"
+#include "memory_management/common/include/allocator_traits.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
+
+namespace {
+constexpr size_t POOL_SIZE = 64U * 1024U;
+
+std::string TracePath(const char *name)
+{
+    return testing::TempDir() + name;
+}
+}  // namespace
+
+static_assert(CAN_FREE_ONE<TracingAllocator<FreeListAllocator<POOL_SIZE>>>);
+static_assert(!CAN_FREE_ONE<TracingAllocator<BumpPointerAllocator<POOL_SIZE>>>);
+static_assert(CAN_ALLOCATE_ONE<TracingAllocator<RunOfSlotsAllocator<POOL_SIZE, 8U, 16U>>, uint64_t>);
+static_assert(!CAN_ALLOCATE_ONE<TracingAllocator<FreeListAllocator<POOL_SIZE>>, uint64_t>);
+
+TEST(AllocationTraceTest, RecordReadTest)
+{
+    std::string path = TracePath("record_read.trace");
+    FreeListAllocator<POOL_SIZE> allocator;
+    {
+        auto recorder = TraceRecorder::Open(path.c_str());
+        ASSERT_NE(recorder, nullptr);
+        TracingAllocator traced(allocator, *recorder);
+        auto *first = traced.Allocate<uint32_t>(4U);
+        auto *second = traced.AllocateAligned<uint8_t>(100U, 64U);
+        ASSERT_NE(first, nullptr);
+        ASSERT_NE(second, nullptr);
+        traced.Free(first);
+        // the same address gets a new id when it is allocated again
+        auto *third = traced.Allocate<uint32_t>(4U);
+        traced.Free(second);
+        traced.Free(third);
+        // unknown pointers and failed allocations are not recorded
+        traced.Free(nullptr);
+        ASSERT_EQ(traced.Allocate<uint8_t>(POOL_SIZE * 2U), nullptr);
+        ASSERT_EQ(recorder->GetEventsCount(), 6U);
+    }
+    std::vector<TraceEvent> events;
+    ASSERT_TRUE(ReadTrace(path.c_str(), events));
+    ASSERT_EQ(events.size(), 6U);
+    const TraceEventKind kinds[] = {TraceEventKind::ALLOCATE, TraceEventKind::ALLOCATE, TraceEventKind::FREE,
+                                    TraceEventKind::ALLOCATE, TraceEventKind::FREE,     TraceEventKind::FREE};
+    const uint32_t ids[] = {0U, 1U, 0U, 2U, 1U, 2U};
+    for (size_t i = 0U; i < events.size(); ++i) {
+        ASSERT_EQ(events[i].kind, kinds[i]);
+        ASSERT_EQ(events[i].pointerId, ids[i]);
+        ASSERT_EQ(events[i].threadId, events[0].threadId);
+        if (i > 0U) {
+            ASSERT_GE(events[i].timestampNs, events[i - 1U].timestampNs);
+        }
+    }
+    ASSERT_EQ(events[0].size, 4U * sizeof(uint32_t));
+    ASSERT_EQ(events[1].size, 100U);
+    ASSERT_EQ(events[1].alignLog2, 6U);
+    ASSERT_EQ(events[2].size, 0U);
+    std::remove(path.c_str());
+}
+
+TEST(AllocationTraceTest, FreeAllTest)
+{
+    std::string path = TracePath("free_all.trace");
+    BumpPointerAllocator<POOL_SIZE> allocator;
+    {
+        auto recorder = TraceRecorder::Open(path.c_str());
+        ASSERT_NE(recorder, nullptr);
+        TracingAllocator traced(allocator, *recorder);
+        ASSERT_NE(traced.Allocate<uint64_t>(2U), nullptr);
+        traced.Free();
+        ASSERT_NE(traced.Allocate<uint64_t>(2U), nullptr);
+    }
+    std::vector<TraceEvent> events;
+    ASSERT_TRUE(ReadTrace(path.c_str(), events));
+    ASSERT_EQ(events.size(), 3U);
+    ASSERT_EQ(events[1].kind, TraceEventKind::FREE_ALL);
+    ASSERT_EQ(events[2].pointerId, 1U);
+    std::remove(path.c_str());
+}
+
+TEST(AllocationTraceTest, AllocateOneTest)
+{
+    std::string path = TracePath("allocate_one.trace");
+    RunOfSlotsAllocator<POOL_SIZE, 8U, 16U> allocator;
+    {
+        auto recorder = TraceRecorder::Open(path.c_str());
+        ASSERT_NE(recorder, nullptr);
+        TracingAllocator traced(allocator, *recorder);
+        auto *mem = traced.Allocate<uint64_t>();
+        ASSERT_NE(mem, nullptr);
+        traced.Free(mem);
+    }
+    std::vector<TraceEvent> events;
+    ASSERT_TRUE(ReadTrace(path.c_str(), events));
+    ASSERT_EQ(events.size(), 2U);
+    ASSERT_EQ(events[0].size, sizeof(uint64_t));
+    ASSERT_EQ(events[0].alignLog2, 3U);
+    std::remove(path.c_str());
+}
+
+TEST(AllocationTraceTest, ThreadsTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    // more events than the buffer holds
+    constexpr size_t ALLOCATIONS_COUNT = 3000U;
+    std::string path = TracePath("threads.trace");
+    {
+        auto recorder = TraceRecorder::Open(path.c_str());
+        ASSERT_NE(recorder, nullptr);
+        std::vector<std::thread> threads;
+        for (size_t i = 0U; i < THREADS_COUNT; ++i) {
+            threads.emplace_back([&recorder] {
+                FreeListAllocator<POOL_SIZE> allocator;
+                TracingAllocator traced(allocator, *recorder);
+                for (size_t j = 0U; j < ALLOCATIONS_COUNT; ++j) {
+                    traced.Free(traced.Allocate<uint64_t>(1U));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+    std::vector<TraceEvent> events;
+    ASSERT_TRUE(ReadTrace(path.c_str(), events));
+    ASSERT_EQ(events.size(), THREADS_COUNT * ALLOCATIONS_COUNT * 2U);
+    std::set<uint16_t> threadIds;
+    std::set<uint32_t> pointerIds;
+    for (const TraceEvent &event : events) {
+        threadIds.insert(event.threadId);
+        if (event.kind == TraceEventKind::ALLOCATE) {
+            ASSERT_TRUE(pointerIds.insert(event.pointerId).second);
+        }
+    }
+    ASSERT_EQ(threadIds.size(), THREADS_COUNT);
+    ASSERT_EQ(pointerIds.size(), THREADS_COUNT * ALLOCATIONS_COUNT);
+    std::remove(path.c_str());
+}
+
+TEST(AllocationTraceTest, InvalidFileTest)
+{
+    std::vector<TraceEvent> events;
+    ASSERT_FALSE(ReadTrace(TracePath("missing.trace").c_str(), events));
+    ASSERT_EQ(TraceRecorder::Open("/nonexistent/dir/file.trace"), nullptr);
+    std::string path = TracePath("invalid.trace");
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not a trace at all", file);
+    std::fclose(file);
+    ASSERT_FALSE(ReadTrace(path.c_str(), events));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+#include "memory_management/common/include/allocator_traits.h"
+#include "memory_management/common/include/heap_profiler.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+
+namespace {
+constexpr size_t POOL_SIZE = 1024U * 1024U;
+constexpr size_t ALLOCATION_SIZE = 64U;
+
+using Allocator = FreeListAllocator<POOL_SIZE>;
+
+// allocations of this function have their own stack trace
+NO_INLINE void *AllocateAt(ProfiledAllocator<Allocator> &profiled)
+{
+    return profiled.Allocate<uint8_t>(ALLOCATION_SIZE);
+}
+
+HeapProfileEntry ProfileTotal()
+{
+    HeapProfileEntry total;
+    for (const HeapProfileEntry &entry : HeapProfiler::Instance().GetProfile()) {
+        EXPECT_FALSE(entry.stack.empty());
+        total.inuseCount += entry.inuseCount;
+        total.inuseBytes += entry.inuseBytes;
+        total.allocCount += entry.allocCount;
+        total.allocBytes += entry.allocBytes;
+    }
+    return total;
+}
+
+class HeapProfilerTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        HeapProfiler::Instance().Clear();
+    }
+
+    void TearDown() override
+    {
+        HeapProfiler::Instance().SetSamplePeriod(HeapProfiler::DEFAULT_SAMPLE_PERIOD);
+        HeapProfiler::Instance().Clear();
+    }
+};
+}  // namespace
+
+static_assert(CAN_FREE_ONE<ProfiledAllocator<Allocator>>);
+static_assert(!CAN_FREE_ONE<ProfiledAllocator<BumpPointerAllocator<POOL_SIZE>>>);
+
+TEST_F(HeapProfilerTest, DisabledTest)
+{
+    HeapProfiler::Instance().SetSamplePeriod(0U);
+    Allocator allocator;
+    ProfiledAllocator profiled(allocator);
+    for (size_t i = 0U; i < 1000U; ++i) {
+        profiled.Free(AllocateAt(profiled));
+    }
+    ASSERT_TRUE(HeapProfiler::Instance().GetProfile().empty());
+}
+
+TEST_F(HeapProfilerTest, InuseTest)
+{
+    constexpr size_t ALLOCATIONS_COUNT = 100U;
+    // the mean distance is 1 byte, so every allocation is sampled
+    HeapProfiler::Instance().SetSamplePeriod(1U);
+    Allocator allocator;
+    ProfiledAllocator profiled(allocator);
+    std::vector<void *> ptrs;
+    for (size_t i = 0U; i < ALLOCATIONS_COUNT; ++i) {
+        ptrs.push_back(AllocateAt(profiled));
+        ASSERT_NE(ptrs.back(), nullptr);
+    }
+    auto profile = HeapProfiler::Instance().GetProfile();
+    ASSERT_EQ(profile.size(), 1U);
+    ASSERT_EQ(profile[0].inuseCount, ALLOCATIONS_COUNT);
+    ASSERT_EQ(profile[0].inuseBytes, ALLOCATIONS_COUNT * ALLOCATION_SIZE);
+    for (size_t i = 0U; i < ALLOCATIONS_COUNT / 2U; ++i) {
+        profiled.Free(ptrs[i]);
+    }
+    HeapProfileEntry total = ProfileTotal();
+    ASSERT_EQ(total.inuseCount, ALLOCATIONS_COUNT / 2U);
+    ASSERT_EQ(total.allocCount, ALLOCATIONS_COUNT);
+    ASSERT_EQ(total.allocBytes, ALLOCATIONS_COUNT * ALLOCATION_SIZE);
+    for (size_t i = ALLOCATIONS_COUNT / 2U; i < ALLOCATIONS_COUNT; ++i) {
+        profiled.Free(ptrs[i]);
+    }
+    ASSERT_EQ(ProfileTotal().inuseBytes, 0U);
+}
+
+TEST_F(HeapProfilerTest, SampleRateTest)
+{
+    constexpr size_t PERIOD = 4096U;
+    constexpr size_t ALLOCATIONS_COUNT = 200000U;
+    HeapProfiler::Instance().SetSamplePeriod(PERIOD);
+    Allocator allocator;
+    ProfiledAllocator profiled(allocator);
+    for (size_t i = 0U; i < ALLOCATIONS_COUNT; ++i) {
+        profiled.Free(AllocateAt(profiled));
+    }
+    // about 3125 samples are expected, the bound is far beyond their deviation
+    constexpr double EXPECTED = static_cast<double>(ALLOCATIONS_COUNT * ALLOCATION_SIZE) / PERIOD;
+    HeapProfileEntry total = ProfileTotal();
+    ASSERT_GT(static_cast<double>(total.allocCount), EXPECTED * 0.8);
+    ASSERT_LT(static_cast<double>(total.allocCount), EXPECTED * 1.2);
+    ASSERT_EQ(total.inuseCount, 0U);
+}
+
+TEST_F(HeapProfilerTest, ThreadsTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    constexpr size_t ALLOCATIONS_COUNT = 1000U;
+    HeapProfiler::Instance().SetSamplePeriod(1U);
+    std::vector<std::thread> threads;
+    for (size_t i = 0U; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([] {
+            // the countdown of a new thread starts with the first allocation, here it starts with period 1
+            HeapProfiler::Instance().SetSamplePeriod(1U);
+            Allocator allocator;
+            ProfiledAllocator profiled(allocator);
+            std::vector<void *> ptrs;
+            for (size_t j = 0U; j < ALLOCATIONS_COUNT; ++j) {
+                ptrs.push_back(AllocateAt(profiled));
+            }
+            for (void *ptr : ptrs) {
+                profiled.Free(ptr);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    HeapProfileEntry total = ProfileTotal();
+    ASSERT_EQ(total.allocCount, THREADS_COUNT * ALLOCATIONS_COUNT);
+    ASSERT_EQ(total.inuseCount, 0U);
+}
+
+TEST_F(HeapProfilerTest, WriteProfileTest)
+{
+    HeapProfiler::Instance().SetSamplePeriod(1U);
+    Allocator allocator;
+    ProfiledAllocator profiled(allocator);
+    void *ptr = AllocateAt(profiled);
+    std::string path = testing::TempDir() + "heap.prof";
+    ASSERT_TRUE(HeapProfiler::Instance().WriteProfile(path.c_str()));
+    profiled.Free(ptr);
+    std::FILE *file = std::fopen(path.c_str(), "r");
+    ASSERT_NE(file, nullptr);
+    char line[256];  // NOLINT(modernize-avoid-c-arrays)
+    ASSERT_NE(std::fgets(line, sizeof(line), file), nullptr);
+    ASSERT_STREQ(line, "heap profile: 1: 64 [1: 64] @ heap_v2/1\n");
+    ASSERT_NE(std::fgets(line, sizeof(line), file), nullptr);
+    ASSERT_EQ(std::strncmp(line, "1: 64 [1: 64] @ 0x", std::strlen("1: 64 [1: 64] @ 0x")), 0);
+    bool mapped = false;
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        mapped |= std::strcmp(line, "MAPPED_LIBRARIES:\n") == 0;
+    }
+    std::fclose(file);
+    std::remove(path.c_str());
+    ASSERT_TRUE(mapped);
+    ASSERT_FALSE(HeapProfiler::Instance().WriteProfile("/nonexistent/dir/heap.prof"));
+}
+
+TEST_F(HeapProfilerTest, ReusedAddressTest)
+{
+    HeapProfiler::Instance().SetSamplePeriod(1U);
+    BumpPointerAllocator<POOL_SIZE> allocator;
+    ProfiledAllocator profiled(allocator);
+    auto *first = profiled.Allocate<uint8_t>(ALLOCATION_SIZE);
+    ASSERT_NE(first, nullptr);
+    // memory freed at once is not reported, the sample of the old allocation is retired when the address is reused
+    profiled.Free();
+    ASSERT_EQ(profiled.Allocate<uint8_t>(ALLOCATION_SIZE), first);
+    HeapProfileEntry total = ProfileTotal();
+    ASSERT_EQ(total.inuseCount, 1U);
+    ASSERT_EQ(total.inuseBytes, ALLOCATION_SIZE);
+    ASSERT_EQ(total.allocCount, 2U);
+}
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "memory_management/common/include/numa.h"
+
+TEST(NumaTest, NodesTest)
+{
+    ASSERT_GE(NumaNodesCount(), 1U);
+    ASSERT_LT(CurrentNumaNode(), NumaNodesCount());
+}
+
+TEST(NumaTest, NumaPageSourceTest)
+{
+    constexpr size_t SIZE = 3U * 4096U + 100U;
+    constexpr size_t ALIGN = 1U << 16U;
+    // the binding is only a hint, memory is given on any machine
+    for (size_t node : {CurrentNumaNode(), NumaNodesCount() - 1U, NumaPageSource::ANY_NODE}) {
+        NumaPageSource source(node);
+        ASSERT_EQ(source.GetNode(), node);
+        void *mem = source.Map(SIZE, ALIGN);
+        ASSERT_NE(mem, nullptr);
+        ASSERT_TRUE(IsAligned(reinterpret_cast<uintptr_t>(mem), ALIGN));
+        std::memset(mem, 0xFF, SIZE);
+        source.Unmap(mem, SIZE, ALIGN);
+    }
+}
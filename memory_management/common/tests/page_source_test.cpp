@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "memory_management/common/include/page_source.h"
+
+namespace {
+template <class PageSource>
+void CheckMapUnmap(PageSource &source)
+{
+    constexpr size_t SIZE = 3U * 4096U + 100U;
+    for (size_t align : {size_t {16U}, size_t {4096U}, size_t {1U} << 16U, size_t {1U} << 22U}) {
+        void *mem = source.Map(SIZE, align);
+        ASSERT_NE(mem, nullptr);
+        ASSERT_TRUE(IsAligned(reinterpret_cast<uintptr_t>(mem), align));
+        std::memset(mem, 0xFF, SIZE);
+        source.Unmap(mem, SIZE, align);
+    }
+}
+}  // namespace
+
+TEST(PageSourceTest, NewPageSourceTest)
+{
+    NewPageSource source;
+    CheckMapUnmap(source);
+}
+
+TEST(PageSourceTest, MmapPageSourceTest)
+{
+    MmapPageSource source;
+    CheckMapUnmap(source);
+}
+
+TEST(PageSourceTest, HugePageSourceTest)
+{
+    // reserved huge pages may be missing, then the memory comes from the transparent huge pages fallback
+    HugePageSource source;
+    CheckMapUnmap(source);
+    void *mem = source.Map(1U, 1U);
+    ASSERT_NE(mem, nullptr);
+    ASSERT_TRUE(IsAligned(reinterpret_cast<uintptr_t>(mem), HugePageSource::HUGE_PAGE_SIZE));
+    source.Unmap(mem, 1U, 1U);
+}
+
+TEST(PageSourceTest, BufferPageSourceTest)
+{
+    constexpr size_t BUFFER_SIZE = 1U << 16U;
+    constexpr size_t SIZE = 4096U;
+    std::vector<uint8_t> buffer(2U * BUFFER_SIZE);
+    // the source gets a buffer aligned to its size
+    auto *begin = reinterpret_cast<uint8_t *>(AlignUp(reinterpret_cast<uintptr_t>(buffer.data()), BUFFER_SIZE));
+    BufferPageSource source(begin, BUFFER_SIZE);
+
+    std::vector<void *> ranges;
+    for (void *mem = source.Map(SIZE, SIZE); mem != nullptr; mem = source.Map(SIZE, SIZE)) {
+        ASSERT_TRUE(IsAligned(reinterpret_cast<uintptr_t>(mem), SIZE));
+        ranges.push_back(mem);
+    }
+    ASSERT_EQ(ranges.size(), BUFFER_SIZE / SIZE);
+    ASSERT_EQ(ranges.front(), begin);
+
+    // unmapped ranges are reused, the last one goes back to the buffer
+    source.Unmap(ranges[1U], SIZE, SIZE);
+    source.Unmap(ranges.back(), SIZE, SIZE);
+    ASSERT_EQ(source.Map(SIZE, SIZE), ranges[1U]);
+    ASSERT_EQ(source.Map(SIZE, SIZE), ranges.back());
+    ASSERT_EQ(source.Map(1U, 1U), nullptr);
+    // a range is not given with a smaller alignment than asked for
+    source.Unmap(ranges[1U], SIZE, SIZE);
+    ASSERT_EQ(source.Map(SIZE, 2U * SIZE), nullptr);
+}
+
+TEST(PageSourceTest, BufferPageSourceSplitTest)
+{
+    constexpr size_t BUFFER_SIZE = 1U << 16U;
+    constexpr size_t SIZE = 4096U;
+    std::vector<uint8_t> buffer(BUFFER_SIZE);
+    BufferPageSource source(buffer.data(), BUFFER_SIZE);
+    void *big = source.Map(4U * SIZE, 1U);
+    ASSERT_NE(big, nullptr);
+    ASSERT_NE(source.Map(BUFFER_SIZE - 4U * SIZE, 1U), nullptr);
+
+    // a smaller request takes the head of a bigger free range, the tail is kept for the next ones
+    source.Unmap(big, 4U * SIZE, 1U);
+    auto *head = static_cast<uint8_t *>(source.Map(SIZE, 1U));
+    ASSERT_EQ(head, big);
+    ASSERT_EQ(source.Map(SIZE, 1U), head + SIZE);
+    ASSERT_EQ(source.Map(2U * SIZE, 1U), head + 2U * SIZE);
+    ASSERT_EQ(source.Map(1U, 1U), nullptr);
+}
+
+TEST(PageSourceTest, BufferPageSourcePaddingTest)
+{
+    constexpr size_t BUFFER_SIZE = 1U << 16U;
+    constexpr size_t SIZE = 4096U;
+    std::vector<uint8_t> buffer(2U * BUFFER_SIZE);
+    auto *begin = reinterpret_cast<uint8_t *>(AlignUp(reinterpret_cast<uintptr_t>(buffer.data()), BUFFER_SIZE));
+    BufferPageSource source(begin, BUFFER_SIZE);
+
+    // the padding before an aligned range is free memory too
+    ASSERT_EQ(source.Map(SIZE, SIZE), begin);
+    auto *aligned = static_cast<uint8_t *>(source.Map(SIZE, 4U * SIZE));
+    ASSERT_EQ(aligned, begin + 4U * SIZE);
+    ASSERT_EQ(source.Map(2U * SIZE, SIZE), begin + SIZE);
+    ASSERT_EQ(source.Map(SIZE, 1U), begin + 3U * SIZE);
+    // a free range which is not aligned itself gives its aligned part
+    source.Unmap(begin + SIZE, 2U * SIZE, SIZE);
+    source.Unmap(begin + 3U * SIZE, SIZE, 1U);
+    ASSERT_EQ(source.Map(SIZE, 2U * SIZE), begin + 2U * SIZE);
+    ASSERT_EQ(source.Map(SIZE, 1U), begin + SIZE);
+    ASSERT_EQ(source.Map(SIZE, 1U), begin + 3U * SIZE);
+}
+
+TEST(PageSourceTest, BufferPageSourceMergeTest)
+{
+    constexpr size_t BUFFER_SIZE = 1U << 16U;
+    constexpr size_t SIZE = 4096U;
+    constexpr size_t COUNT = BUFFER_SIZE / SIZE;
+    std::vector<uint8_t> buffer(BUFFER_SIZE);
+    BufferPageSource source(buffer.data(), BUFFER_SIZE);
+
+    std::vector<void *> ranges;
+    for (size_t i = 0; i < COUNT; ++i) {
+        ranges.push_back(source.Map(SIZE, 1U));
+        ASSERT_NE(ranges.back(), nullptr);
+    }
+    // neighbouring ranges are merged whatever order they are unmapped in
+    source.Unmap(ranges[1U], SIZE, 1U);
+    source.Unmap(ranges[3U], SIZE, 1U);
+    source.Unmap(ranges[2U], SIZE, 1U);
+    ASSERT_EQ(source.Map(3U * SIZE, 1U), ranges[1U]);
+
+    // free ranges reaching the top give the whole buffer back
+    source.Unmap(ranges[1U], 3U * SIZE, 1U);
+    for (size_t i = COUNT; i > 0U; --i) {
+        size_t idx = (i * 7U) % COUNT;
+        if (idx < 1U || idx > 3U) {
+            source.Unmap(ranges[idx], SIZE, 1U);
+        }
+    }
+    ASSERT_EQ(source.Map(BUFFER_SIZE, 1U), buffer.data());
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "memory_management/common/include/pool_map.h"
+
+TEST(PoolMapTest, InsertEraseTest)
+{
+    constexpr size_t POOL_ALIGN = 4096U;
+    constexpr size_t POOLS_COUNT = 1000U;
+    PoolMap map(POOL_ALIGN);
+
+    std::vector<uintptr_t> bases;
+    for (size_t i = 1U; i <= POOLS_COUNT; ++i) {
+        bases.push_back(i * POOL_ALIGN);
+        ASSERT_TRUE(map.Insert(bases.back()));
+    }
+    for (uintptr_t base : bases) {
+        ASSERT_TRUE(map.Contains(base));
+        ASSERT_TRUE(map.ContainsPoolOf(reinterpret_cast<void *>(base + POOL_ALIGN - 1U)));
+    }
+    ASSERT_FALSE(map.Contains((POOLS_COUNT + 1U) * POOL_ALIGN));
+    ASSERT_FALSE(map.ContainsPoolOf(nullptr));
+
+    // erasing every other pool should not break probe sequences of the rest
+    for (size_t i = 0; i < bases.size(); i += 2U) {
+        map.Erase(bases[i]);
+    }
+    for (size_t i = 0; i < bases.size(); ++i) {
+        ASSERT_EQ(map.Contains(bases[i]), i % 2U != 0U);
+    }
+}
@@ -0,0 +1,164 @@
+#ifndef MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_CONCURRENT_FREE_LIST_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_CONCURRENT_FREE_LIST_ALLOCATOR_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include "base/alignment.h"
+#include "base/macros.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+
+/**
+ * @brief Concurrent FreeListAllocator split into SHARDS_COUNT independent shards, each with its own lock and pools.
+ * Every thread allocates from its own shard, threads are spread over shards round robin. Memory is freed to the owner
+ * shard right away if its lock is free, otherwise it is pushed to the lock-free remote free list of the owner, which
+ * is drained under the owner lock on its next allocation or free. Memory which still waits in the list of a shard
+ * whose thread is gone is reclaimed by Trim(). The owner shard of a pointer is found in O(1) from its pool header.
+ */
+template <size_t ONE_MEM_POOL_SIZE, size_t SHARDS_COUNT = 16U>
+class ConcurrentFreeListAllocator {
+    static_assert(SHARDS_COUNT != 0U, "there should be at least one shard");
+
+    using ShardAllocator = FreeListAllocator<ONE_MEM_POOL_SIZE>;
+
+public:
+    ConcurrentFreeListAllocator() = default;
+    ~ConcurrentFreeListAllocator() = default;
+    NO_COPY_SEMANTIC(ConcurrentFreeListAllocator);
+    NO_MOVE_SEMANTIC(ConcurrentFreeListAllocator);
+
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned to alignof(T)
+     */
+    template <class T = uint8_t>
+    T *Allocate(size_t count)
+    {
+        return AllocateAligned<T>(count, alignof(T));
+    }
+
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned to @param align
+     * @param align should be a power of two, alignment less than alignof(T) is raised to alignof(T)
+     */
+    template <class T = uint8_t>
+    T *AllocateAligned(size_t count, size_t align)
+    {
+        Shard &shard = shards_[CurrentShard()];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.remoteFrees.load(std::memory_order_relaxed) != nullptr) {
+            DrainRemoteFrees(shard);
+        }
+        return shard.allocator.template AllocateAligned<T>(count, align);
+    }
+
+    /**
+     * @brief Frees @param ptr allocated by any thread
+     */
+    void Free(void *ptr)
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        Shard &owner = ShardOf(ptr);
+        // a busy owner is not waited for, an idle one also takes the frees which wait for it
+        if (owner.mutex.try_lock()) {
+            owner.allocator.Free(ptr);
+            if (owner.remoteFrees.load(std::memory_order_relaxed) != nullptr) {
+                DrainRemoteFrees(owner);
+            }
+            owner.mutex.unlock();
+            return;
+        }
+        auto *node = new (ptr) RemoteFree {owner.remoteFrees.load(std::memory_order_relaxed)};
+        while (!owner.remoteFrees.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                                        std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Method should check in @param ptr is pointer to mem from this allocator.
+     * It locks every shard, so it is meant for debugging only
+     * @returns true if ptr is from this allocator
+     */
+    bool VerifyPtr(void *ptr)
+    {
+        for (Shard &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            DrainRemoteFrees(shard);
+            if (shard.allocator.VerifyPtr(ptr)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gives all empty pools of all shards back to the heap. Frees which wait for an idle shard are taken
+     * first, so it reclaims memory of shards whose threads do not allocate anymore
+     * @returns count of released pools
+     */
+    size_t Trim()
+    {
+        size_t released = 0U;
+        for (Shard &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            DrainRemoteFrees(shard);
+            released += shard.allocator.Trim();
+        }
+        return released;
+    }
+
+    // @returns allocator of shard @param shard, it should be used under no concurrent access
+    ShardAllocator &GetShardAllocator(size_t shard)
+    {
+        return shards_[shard % SHARDS_COUNT].allocator;
+    }
+
+private:
+    // freed memory waiting in a remote free list, it is placed in the memory itself
+    struct RemoteFree {
+        RemoteFree *next;
+    };
+
+    // every shard is on its own cache lines, so threads working with different shards do not interfere
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::mutex mutex;
+        std::atomic<RemoteFree *> remoteFrees {nullptr};
+        ShardAllocator allocator;
+    };
+
+    // @returns shard of the calling thread
+    static size_t CurrentShard()
+    {
+        static std::atomic<size_t> threadsCount {0U};
+        thread_local size_t shard = threadsCount.fetch_add(1U, std::memory_order_relaxed) % SHARDS_COUNT;
+        return shard;
+    }
+
+    Shard &ShardOf(const void *ptr)
+    {
+        // shards are in one array, so the distance between their allocators is a multiple of the shard size
+        auto owner = reinterpret_cast<uintptr_t>(ShardAllocator::OwnerOf(ptr));
+        auto first = reinterpret_cast<uintptr_t>(&shards_[0].allocator);
+        return shards_[(owner - first) / sizeof(Shard)];
+    }
+
+    // should be called under the lock of @param shard
+    static void DrainRemoteFrees(Shard &shard)
+    {
+        // the whole list is taken at once, so there is no ABA problem with concurrent pushes
+        RemoteFree *node = shard.remoteFrees.exchange(nullptr, std::memory_order_acquire);
+        while (node != nullptr) {
+            RemoteFree *next = node->next;
+            shard.allocator.Free(node);
+            node = next;
+        }
+    }
+
+    std::array<Shard, SHARDS_COUNT> shards_ {};
+};
+
+#endif  // MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_CONCURRENT_FREE_LIST_ALLOCATOR_H
@@ -1,47 +1,1108 @@
 #ifndef MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
 #define MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "base/alignment.h"
 #include "base/macros.h"
+#include "memory_management/common/include/allocator_stats.h"
+#include "memory_management/common/include/page_source.h"
+#include "memory_management/common/include/pool_map.h"
 
-template <size_t ONE_MEM_POOL_SIZE>
+template <size_t ONE_MEM_POOL_SIZE, size_t SHARDS_COUNT>
+class ConcurrentFreeListAllocator;
+
+/**
+ * @brief Allocates memory of any size from pools of ONE_MEM_POOL_SIZE bytes taken from PageSource (see page_source.h)
+ */
+template <size_t ONE_MEM_POOL_SIZE, class PageSource = NewPageSource>
 class FreeListAllocator {
     // here we recommend you to use class MemoryPool. Use new to allocate them from heap.
     // remember, you can not use any containers with heap allocations
     template <size_t MEM_POOL_SIZE>
     class FreeListMemoryPool;
 
+    using MemoryPool = FreeListMemoryPool<ONE_MEM_POOL_SIZE>;
+
 public:
     FreeListAllocator() = default;
-    ~FreeListAllocator() = default;
+    explicit FreeListAllocator(PageSource source) : source_(source) {}
+    ~FreeListAllocator()
+    {
+        while (pools_ != nullptr) {
+            MemoryPool *next = pools_->GetNext();
+            MemoryPool::Destroy(pools_);
+            pools_ = next;
+        }
+    }
     NO_MOVE_SEMANTIC(FreeListAllocator);
     NO_COPY_SEMANTIC(FreeListAllocator);
 
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned to alignof(T)
+     */
     template <class T = uint8_t>
-    T *Allocate([[maybe_unused]]size_t count)
+    T *Allocate(size_t count)
     {
-        // TODO(you): Add your implementation here...
-        return nullptr;
+        return AllocateAligned<T>(count, alignof(T));
+    }
+
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned to @param align
+     * @param align should be a power of two, alignment less than alignof(T) is raised to alignof(T)
+     */
+    template <class T = uint8_t>
+    T *AllocateAligned(size_t count, size_t align)
+    {
+        T *mem = AllocateFromPools<T>(count, align);
+        STATS_ONLY(counters_.OnAllocate(mem != nullptr));
+        return mem;
+    }
+    /**
+     * @brief Resizes memory of @param ptr to @param newCount objects of type T. Growing takes the next block when
+     * it is free and big enough, shrinking gives the tail back. Otherwise new memory aligned to alignof(T) is
+     * allocated, the contents are copied bytewise and @param ptr is freed
+     * @returns new address of the memory or nullptr if there is no memory, @param ptr stays valid in that case
+     */
+    template <class T = uint8_t>
+    T *Reallocate(T *ptr, size_t newCount)
+    {
+        if (ptr == nullptr) {
+            return Allocate<T>(newCount);
+        }
+        if (UNLIKELY(newCount == 0U || newCount > MemoryPool::MaxPayload() / sizeof(T))) {
+            return nullptr;
+        }
+        MemoryPool *pool = PoolOf(ptr);
+        if (pool->Resize(ptr, newCount * sizeof(T))) {
+            Refile(pool);
+            return ptr;
+        }
+        T *mem = Allocate<T>(newCount);
+        if (mem != nullptr) {
+            size_t oldSize = MemoryPool::PayloadSizeOf(ptr);
+            std::memcpy(mem, ptr, oldSize < newCount * sizeof(T) ? oldSize : newCount * sizeof(T));
+            Free(ptr);
+        }
+        return mem;
+    }
+
+    /**
+     * @brief Allocates @param count separate objects of type T and writes their addresses to @param out.
+     * Every pool with free space is tried once for the whole batch
+     * @returns count of allocated objects, it is less than @param count only if there is no memory
+     */
+    template <class T = uint8_t>
+    size_t AllocateBatch(size_t count, T **out)
+    {
+        constexpr size_t SIZE = sizeof(T);
+        constexpr size_t ALIGN = alignof(T);
+        if constexpr (!MemoryPool::CanFit(SIZE, ALIGN)) {
+            STATS_ONLY(counters_.OnAllocate(false));
+            return 0U;
+        } else {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            size_t allocated = 0U;
+            TryPoolsWithFree(MemoryPool::BlockSize(SIZE), [&](MemoryPool *pool) {
+                allocated += pool->AllocateBatch(SIZE, ALIGN, out + allocated, count - allocated);
+                return allocated == count;
+            });
+            while (allocated < count) {
+                MemoryPool *pool = CreatePool();
+                if (pool == nullptr) {
+                    break;
+                }
+                allocated += pool->AllocateBatch(SIZE, ALIGN, out + allocated, count - allocated);
+            }
+            // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            STATS_ONLY(counters_.OnAllocateBatch(count, allocated));
+            return allocated;
+        }
+    }
+
+    /**
+     * @brief Frees @param count objects from @param ptrs, which should not contain nullptr.
+     * Pool lookup is done once for every run of neighbouring pointers of the same pool
+     */
+    template <class T>
+    void FreeBatch(T *const *ptrs, size_t count)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size_t begin = 0U;
+        while (begin < count) {
+            MemoryPool *pool = PoolOf(ptrs[begin]);
+            size_t end = begin + 1U;
+            while (end < count && PoolOf(ptrs[end]) == pool) {
+                ++end;
+            }
+            pool->FreeBatch(ptrs + begin, end - begin);
+            Refile(pool);
+            STATS_ONLY(counters_.OnFree(end - begin));
+            if (UNLIKELY(pool->IsEmpty())) {
+                OnPoolEmptied(pool);
+            }
+            begin = end;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     }
 
     void Free(void *ptr)
     {
-        // TODO(you): Add your implementation here...
+        if (ptr == nullptr) {
+            return;
+        }
+        MemoryPool *pool = PoolOf(ptr);
+        pool->Free(ptr);
+        Refile(pool);
+        STATS_ONLY(counters_.OnFree());
+        if (UNLIKELY(pool->IsEmpty())) {
+            OnPoolEmptied(pool);
+        }
+    }
+
+    /**
+     * @brief Gives all empty pools back to the heap
+     * @returns count of released pools
+     */
+    size_t Trim()
+    {
+        emptyPool_ = nullptr;
+        size_t released = 0U;
+        MemoryPool *pool = pools_;
+        while (pool != nullptr) {
+            MemoryPool *next = pool->GetNext();
+            if (pool->IsEmpty()) {
+                ReleasePool(pool);
+                ++released;
+            }
+            pool = next;
+        }
+        return released;
+    }
+
+    /**
+     * @brief Checks in O(1) if @param ptr lies in one of the pools, it is safe for any pointer.
+     * Unlike VerifyPtr() the memory may be free
+     */
+    bool OwnsPoolOf(const void *ptr) const
+    {
+        return poolMap_.ContainsPoolOf(ptr);
+    }
+
+    // @returns allocator of @param ptr, which should be live memory of any FreeListAllocator of this size
+    static FreeListAllocator *OwnerOf(const void *ptr)
+    {
+        return reinterpret_cast<MemoryPool *>(AlignDown(reinterpret_cast<uintptr_t>(ptr), POOL_ALIGN))->GetOwner();
     }
 
     /**
      * @brief Method should check in @param ptr is pointer to mem from this allocator
      * @returns true if ptr is from this allocator
      */
-    bool VerifyPtr([[maybe_unused]] void *ptr)  // TODO(you): remove [[maybe_unused]]
+    bool VerifyPtr(void *ptr)
     {
-        // TODO(you): Add your implementation here...
-        return false;
+        // the pool header can be read only after the address is known to be a pool
+        return poolMap_.ContainsPoolOf(ptr) && PoolOf(ptr)->IsAllocated(ptr);
     }
 
+#ifdef ALLOCATOR_STATS
+    AllocatorStats GetStats() const
+    {
+        AllocatorStats stats;
+        stats.reservedBytes = sizeof(FreeListAllocator);
+        for (const MemoryPool *pool = pools_; pool != nullptr; pool = pool->GetNext()) {
+            ++stats.poolsCount;
+            stats.reservedBytes += ONE_MEM_POOL_SIZE;
+            pool->CollectStats(stats);
+        }
+        counters_.Finish(stats);
+        return stats;
+    }
+#endif
+
 private:
-    // TODO(you): Add your fields and methods here...
+    template <class T>
+    T *AllocateFromPools(size_t count, size_t align)
+    {
+        if (UNLIKELY(count == 0U || !IsPowerOfTwo(align) || count > MemoryPool::MaxPayload() / sizeof(T))) {
+            return nullptr;
+        }
+        align = align < alignof(T) ? alignof(T) : align;
+        size_t size = count * sizeof(T);
+        void *mem = nullptr;
+        TryPoolsWithFree(MemoryPool::BlockSize(size), [&](MemoryPool *pool) {
+            mem = pool->Allocate(size, align);
+            return mem != nullptr;
+        });
+        if (mem != nullptr) {
+            return static_cast<T *>(mem);
+        }
+        if (!MemoryPool::CanFit(size, align)) {
+            return nullptr;
+        }
+        MemoryPool *pool = CreatePool();
+        if (pool == nullptr) {
+            return nullptr;
+        }
+        return static_cast<T *>(pool->Allocate(size, align));
+    }
+
+    // pools are filed by the size class of their largest free block, a class is the log2 of the block size
+    static constexpr size_t FREE_CLASSES_COUNT = 64U;
+    static constexpr size_t NOT_FILED = FREE_CLASSES_COUNT;
+
+    static size_t FreeClassOf(size_t blockSize)
+    {
+        return FREE_CLASSES_COUNT - 1U - static_cast<size_t>(__builtin_clzll(blockSize));
+    }
+
+    /**
+     * @brief Calls @param allocate(pool) for pools whose largest free block may hold @param blockSize till it
+     * returns true. Pools are tried from the class of the block up, so big free blocks are kept longer. A pool is
+     * filed by a bound of its largest free block: the pool which can not allocate is recounted and refiled, so it
+     * is not tried again for this size
+     */
+    template <class Allocate>
+    void TryPoolsWithFree(size_t blockSize, Allocate allocate)
+    {
+        uint64_t filed = poolsByFreeMap_ & (~uint64_t {0U} << FreeClassOf(blockSize));
+        while (filed != 0U) {
+            auto freeClass = static_cast<size_t>(__builtin_ctzll(filed));
+            MemoryPool *pool = poolsByFree_[freeClass];
+            while (pool != nullptr) {
+                MemoryPool *next = pool->GetNextByFree();
+                // allocations never raise the bound, so the pool stays filed
+                if (pool->LargestFreeBound() >= blockSize && allocate(pool)) {
+                    return;
+                }
+                pool->RecountLargestFree();
+                Refile(pool);
+                pool = next;
+            }
+            filed = poolsByFreeMap_ & ~((uint64_t {2U} << freeClass) - 1U);
+        }
+    }
+
+    /**
+     * @brief Moves @param pool to the list of the class of its largest free block, full pools are not filed.
+     * The bound of the block is used, so the pool may stay in a bigger class till TryPoolsWithFree() recounts it
+     */
+    void Refile(MemoryPool *pool)
+    {
+        size_t largest = pool->LargestFreeBound();
+        size_t freeClass = largest == 0U ? NOT_FILED : FreeClassOf(largest);
+        if (freeClass != pool->GetFreeClass()) {
+            Unfile(pool);
+            if (freeClass != NOT_FILED) {
+                pool->File(poolsByFree_[freeClass], freeClass);
+                poolsByFreeMap_ |= uint64_t {1U} << freeClass;
+            }
+        }
+    }
+
+    void Unfile(MemoryPool *pool)
+    {
+        size_t freeClass = pool->GetFreeClass();
+        if (freeClass != NOT_FILED) {
+            pool->Unfile(poolsByFree_[freeClass]);
+            if (poolsByFree_[freeClass] == nullptr) {
+                poolsByFreeMap_ &= ~(uint64_t {1U} << freeClass);
+            }
+        }
+    }
+
+    // pools are aligned to their size rounded up to a power of two, so masking a block address gives the pool
+    static constexpr size_t POOL_ALIGN = RoundUpToPowerOfTwo(ONE_MEM_POOL_SIZE);
+
+    // @returns pool of @param ptr, which should be from this allocator
+    MemoryPool *PoolOf(const void *ptr) const
+    {
+        return reinterpret_cast<MemoryPool *>(poolMap_.PoolBaseOf(ptr));
+    }
+
+
+    // @returns new empty pool linked to the front of pools_ and filed or nullptr if there is no memory
+    MemoryPool *CreatePool()
+    {
+        MemoryPool *pool = MemoryPool::Create(this);
+        if (pool == nullptr) {
+            return nullptr;
+        }
+        if (!poolMap_.Insert(reinterpret_cast<uintptr_t>(pool))) {
+            MemoryPool::Destroy(pool);
+            return nullptr;
+        }
+        pool->Link(pools_);
+        Refile(pool);
+        return pool;
+    }
+
+    void ReleasePool(MemoryPool *pool)
+    {
+        Unfile(pool);
+        pool->Unlink(pools_);
+        poolMap_.Erase(reinterpret_cast<uintptr_t>(pool));
+        MemoryPool::Destroy(pool);
+    }
+
+    /**
+     * @brief One emptied pool is kept for reuse, so a pool which keeps emptying and refilling is not recreated
+     * every time. The kept pool is released when another pool gets empty
+     */
+    void OnPoolEmptied(MemoryPool *pool)
+    {
+        // the kept pool may have been refilled since then, it is left alone in that case
+        if (emptyPool_ != nullptr && emptyPool_ != pool && emptyPool_->IsEmpty()) {
+            ReleasePool(emptyPool_);
+        }
+        emptyPool_ = pool;
+    }
+
+    MemoryPool *pools_ = nullptr;
+    // emptied pool kept for reuse, it is nullptr or one of pools_
+    MemoryPool *emptyPool_ = nullptr;
+    // pools with free blocks by the class of the largest one, bit i is set if poolsByFree_[i] is not empty
+    std::array<MemoryPool *, FREE_CLASSES_COUNT> poolsByFree_ {};
+    uint64_t poolsByFreeMap_ = 0U;
+    PoolMap poolMap_ {POOL_ALIGN};
+    PageSource source_ {};
+    STATS_ONLY(AllocatorCounters counters_;)
+
+    template <size_t POOL_SIZE, size_t SHARDS_COUNT>
+    friend class ConcurrentFreeListAllocator;
+};
+
+/**
+ * @brief Pool of MEM_POOL_SIZE bytes (including this header) split into blocks. The header is at the beginning of
+ * the pool, which is aligned to MEM_POOL_SIZE rounded up to a power of two. Every block starts with boundary tags:
+ * its own size with flags and the size of the previous block if that one is free, so Free() coalesces with both
+ * neighbours in O(1). Small free blocks are kept in segregated bins of exact sizes, a bitmap of non-empty bins gives
+ * a suitable bin with one bit scan. Large free blocks form a treap ordered by size and address, which gives the best
+ * fit in O(log n). Both bins and the treap are intrusive: their links are placed in payloads of free blocks.
+ */
+template <size_t ONE_MEM_POOL_SIZE, class PageSource>
+template <size_t MEM_POOL_SIZE>
+class FreeListAllocator<ONE_MEM_POOL_SIZE, PageSource>::FreeListMemoryPool {
+    struct Block {
+        // flags are kept in the low bits of the size, which is a multiple of BLOCK_ALIGN
+        static constexpr size_t FREE = 1U;
+        static constexpr size_t PREV_FREE = 2U;
+        static constexpr size_t FLAGS = FREE | PREV_FREE;
+
+        size_t Size() const
+        {
+            return sizeAndFlags & ~FLAGS;
+        }
+
+        // keeps flags of the block
+        void SetSize(size_t size)
+        {
+            sizeAndFlags = size | (sizeAndFlags & FLAGS);
+        }
+
+        bool IsFree() const
+        {
+            return (sizeAndFlags & FREE) != 0U;
+        }
+
+        bool IsPrevFree() const
+        {
+            return (sizeAndFlags & PREV_FREE) != 0U;
+        }
+
+        void SetFlag(size_t flag, bool value)
+        {
+            sizeAndFlags = value ? sizeAndFlags | flag : sizeAndFlags & ~flag;
+        }
+
+        // footer of the previous block: its size, valid only if PREV_FREE is set
+        size_t prevSize;
+        // size of the whole block including the header
+        size_t sizeAndFlags;
+        // links of the bin list are placed in the payload, so they are valid only for free blocks
+        Block *next;
+        Block *prev;
+    };
+
+    static constexpr size_t BLOCK_ALIGN = alignof(std::max_align_t);
+    static constexpr size_t HEADER_SIZE = AlignUp(offsetof(Block, next), BLOCK_ALIGN);
+    static constexpr size_t MIN_BLOCK_SIZE = AlignUp(sizeof(Block), BLOCK_ALIGN);
+    static constexpr size_t BITS_IN_WORD = 64U;
+    static constexpr size_t GRANULES_COUNT = MEM_POOL_SIZE / BLOCK_ALIGN;
+    static constexpr size_t POOL_ALIGN = RoundUpToPowerOfTwo(MEM_POOL_SIZE);
+
+    // free block which is not smaller than LARGE_BLOCK_SIZE
+    struct LargeBlock : Block {
+        LargeBlock *left;
+        LargeBlock *right;
+    };
+
+    // blocks smaller than LARGE_BLOCK_SIZE have a bin for every size, bigger ones are kept in the treap
+    static constexpr size_t BINS_COUNT = 16U;
+    static constexpr size_t LARGE_BLOCK_SIZE = BINS_COUNT * BLOCK_ALIGN;
+    static_assert(BINS_COUNT <= BITS_IN_WORD);
+    static_assert(sizeof(LargeBlock) <= LARGE_BLOCK_SIZE);
+
+public:
+    NO_COPY_SEMANTIC(FreeListMemoryPool);
+    NO_MOVE_SEMANTIC(FreeListMemoryPool);
+
+    static FreeListMemoryPool *Create(FreeListAllocator *owner)
+    {
+        void *mem = owner->source_.Map(MEM_POOL_SIZE, POOL_ALIGN);
+        return mem == nullptr ? nullptr : new (mem) FreeListMemoryPool(owner);
+    }
+
+    static void Destroy(FreeListMemoryPool *pool)
+    {
+        FreeListAllocator *owner = pool->GetOwner();
+        pool->~FreeListMemoryPool();
+        owner->source_.Unmap(pool, MEM_POOL_SIZE, POOL_ALIGN);
+    }
+
+    // @returns the biggest payload which can be allocated from an empty pool
+    static constexpr size_t MaxPayload()
+    {
+        return DataSize() < MIN_BLOCK_SIZE ? 0U : DataSize() - HEADER_SIZE;
+    }
+
+    // @returns true if an empty pool can hold @param size bytes aligned to @param align
+    static constexpr bool CanFit(size_t size, size_t align)
+    {
+        // the worst case of over-alignment needs a free block in front of the allocated one
+        size_t padding = align > BLOCK_ALIGN ? align - BLOCK_ALIGN + MIN_BLOCK_SIZE : 0U;
+        return padding <= MaxPayload() && size <= MaxPayload() - padding;
+    }
+
+    FreeListMemoryPool *GetNext() const
+    {
+        return all_.next;
+    }
+
+    FreeListMemoryPool *GetNextByFree() const
+    {
+        return byFree_.next;
+    }
+
+    // @returns class of the list of pools with free blocks which the pool is in
+    size_t GetFreeClass() const
+    {
+        return freeClass_;
+    }
+
+    // the owner never changes, so it can be read without synchronization with the owner
+    FreeListAllocator *GetOwner() const
+    {
+        return owner_;
+    }
+
+    // inserts the pool at the front of the list @param head
+    void Link(FreeListMemoryPool *&head)
+    {
+        LinkTo(head, &FreeListMemoryPool::all_);
+    }
+
+    void Unlink(FreeListMemoryPool *&head)
+    {
+        UnlinkFrom(head, &FreeListMemoryPool::all_);
+    }
+
+    // inserts the pool at the front of the list @param head of pools with free blocks of @param freeClass
+    void File(FreeListMemoryPool *&head, size_t freeClass)
+    {
+        LinkTo(head, &FreeListMemoryPool::byFree_);
+        freeClass_ = freeClass;
+    }
+
+    void Unfile(FreeListMemoryPool *&head)
+    {
+        UnlinkFrom(head, &FreeListMemoryPool::byFree_);
+        freeClass_ = NOT_FILED;
+    }
+
+    // @returns size which is not less than the size of the largest free block, it is exact after a recount
+    size_t LargestFreeBound() const
+    {
+        return largestFree_;
+    }
+
+    // makes LargestFreeBound() the size of the largest free block including its header, 0 if there are none
+    void RecountLargestFree()
+    {
+        if (largestFreeStale_) {
+            Block *largest = FindLargestFree();
+            largestFree_ = largest == nullptr ? 0U : largest->Size();
+            largestFreeStale_ = false;
+        }
+    }
+
+    // @returns size of the block which holds @param size bytes aligned to BLOCK_ALIGN
+    static constexpr size_t BlockSize(size_t size)
+    {
+        return HEADER_SIZE + PayloadSize(size);
+    }
+
+    bool IsEmpty() const
+    {
+        return allocatedCount_ == 0U;
+    }
+
+    void *Allocate(size_t size, size_t align)
+    {
+        size_t payloadSize = PayloadSize(size);
+        size_t blockSize = HEADER_SIZE + payloadSize;
+        if (blockSize < LARGE_BLOCK_SIZE) {
+            // every block in the bins starting from the exact one is big enough, only padding of an over-aligned
+            // payload may not fit
+            uint64_t nonEmpty = binsMap_ & (~uint64_t {0U} << (blockSize / BLOCK_ALIGN));
+            for (; nonEmpty != 0U; nonEmpty &= nonEmpty - 1U) {
+                void *mem = AllocateFromBin(static_cast<size_t>(__builtin_ctzll(nonEmpty)), payloadSize, align);
+                if (mem != nullptr) {
+                    return mem;
+                }
+            }
+        }
+        // the best fit is tried first, the next fits are needed only for over-aligned payloads
+        for (LargeBlock *block = LowerBound(blockSize, 0U); block != nullptr;
+             block = LowerBound(block->Size(), reinterpret_cast<uintptr_t>(block) + 1U)) {
+            void *mem = AllocateFrom(block, payloadSize, align);
+            if (mem != nullptr) {
+                return mem;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Allocates up to @param count blocks of @param size bytes. Blocks are carved back to back from one free
+     * block, which is taken from the bins once, while it lasts. Over-aligned blocks are allocated one by one
+     * @returns count of blocks written to @param out
+     */
+    template <class T>
+    size_t AllocateBatch(size_t size, size_t align, T **out, size_t count)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size_t allocated = 0U;
+        if (align > BLOCK_ALIGN) {
+            for (; allocated < count; ++allocated) {
+                void *mem = Allocate(size, align);
+                if (mem == nullptr) {
+                    break;
+                }
+                out[allocated] = static_cast<T *>(mem);
+            }
+            return allocated;
+        }
+        size_t blockSize = HEADER_SIZE + PayloadSize(size);
+        while (allocated < count) {
+            Block *block = FindBatchBlock(blockSize, count - allocated);
+            if (block == nullptr) {
+                break;
+            }
+            allocated += CarveBatch(block, blockSize, out + allocated, count - allocated);
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return allocated;
+    }
+
+    void Free(void *ptr)
+    {
+        // double free or pointer inside a block
+        assert(IsAllocated(ptr));
+        --allocatedCount_;
+        FreeBlock(BlockOf(ptr));
+    }
+
+    /**
+     * @brief Frees @param count blocks from @param ptrs. Runs of neighbouring blocks in address order, e.g. of one
+     * AllocateBatch(), are joined first, so every run is coalesced and put to the bins once
+     */
+    template <class T>
+    void FreeBatch(T *const *ptrs, size_t count)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size_t i = 0U;
+        while (i < count) {
+            assert(IsAllocated(ptrs[i]));
+            Block *first = BlockOf(ptrs[i]);
+            Block *last = first;
+            --allocatedCount_;
+            for (++i; i < count && BlockOf(ptrs[i]) == NextOf(last); ++i) {
+                assert(IsAllocated(ptrs[i]));
+                last = BlockOf(ptrs[i]);
+                SetStart(last, false);
+                first->SetSize(first->Size() + last->Size());
+                --allocatedCount_;
+            }
+            FreeBlock(first);
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Resizes allocated block of @param ptr to hold @param size bytes without moving it
+     * @returns false if the block can not grow in place
+     */
+    bool Resize(void *ptr, size_t size)
+    {
+        assert(IsAllocated(ptr));
+        auto *block = BlockOf(ptr);
+        size_t blockSize = HEADER_SIZE + PayloadSize(size);
+        if (block->Size() < blockSize) {
+            Block *next = NextOf(block);
+            if (next == nullptr || !next->IsFree() || block->Size() + next->Size() < blockSize) {
+                return false;
+            }
+            RemoveFree(next);
+            SetStart(next, false);
+            block->SetSize(block->Size() + next->Size());
+            // the block after the taken one is not preceded by a free block any more
+            SetFree(block, false);
+        }
+        if (block->Size() - blockSize >= MIN_BLOCK_SIZE) {
+            // the tail is made an allocated block and freed, so it is coalesced with the next block if possible
+            auto *tail = reinterpret_cast<Block *>(reinterpret_cast<uintptr_t>(block) + blockSize);
+            tail->sizeAndFlags = block->Size() - blockSize;
+            block->SetSize(blockSize);
+            SetStart(tail, true);
+            ++allocatedCount_;
+            Free(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(tail) + HEADER_SIZE));
+        }
+        return true;
+    }
+
+#ifdef ALLOCATOR_STATS
+    // adds sizes of blocks of this pool to @param stats
+    void CollectStats(AllocatorStats &stats) const
+    {
+        if constexpr (MaxPayload() != 0U) {
+            for (auto *block = reinterpret_cast<const Block *>(DataBegin()); block != nullptr;
+                 block = NextOf(block)) {
+                size_t payload = block->Size() - HEADER_SIZE;
+                if (!block->IsFree()) {
+                    stats.liveBytes += payload;
+                    continue;
+                }
+                stats.freeBytes += payload;
+                stats.largestFreeBlock = payload > stats.largestFreeBlock ? payload : stats.largestFreeBlock;
+            }
+        }
+    }
+#endif
+
+    // @returns size of the payload of allocated @param ptr, it may be bigger than the requested size
+    static size_t PayloadSizeOf(const void *ptr)
+    {
+        return reinterpret_cast<const Block *>(reinterpret_cast<uintptr_t>(ptr) - HEADER_SIZE)->Size() - HEADER_SIZE;
+    }
+
+    bool Contains(const void *ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        auto begin = reinterpret_cast<uintptr_t>(this);
+        return addr >= begin && addr < begin + MEM_POOL_SIZE;
+    }
+
+    // @returns true if @param ptr is the beginning of an allocated block of this pool
+    bool IsAllocated(const void *ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        if (addr < DataBegin() + HEADER_SIZE || addr >= DataEnd() || !IsAligned(addr, BLOCK_ALIGN)) {
+            return false;
+        }
+        auto *block = reinterpret_cast<const Block *>(addr - HEADER_SIZE);
+        return IsStart(block) && !block->IsFree();
+    }
+
+private:
+    explicit FreeListMemoryPool(FreeListAllocator *owner) : owner_(owner)
+    {
+        if constexpr (MaxPayload() != 0U) {
+            auto *block = reinterpret_cast<Block *>(DataBegin());
+            block->sizeAndFlags = DataSize() | Block::FREE;
+            SetStart(block, true);
+            InsertFree(block);
+        }
+    }
+    ~FreeListMemoryPool() = default;
+
+    static constexpr size_t DataOffset()
+    {
+        return AlignUp(sizeof(FreeListMemoryPool), BLOCK_ALIGN);
+    }
+
+    static constexpr size_t DataSize()
+    {
+        return MEM_POOL_SIZE < DataOffset() ? 0U : AlignDown(MEM_POOL_SIZE - DataOffset(), BLOCK_ALIGN);
+    }
+
+    static constexpr size_t PayloadSize(size_t size)
+    {
+        return size < MIN_BLOCK_SIZE - HEADER_SIZE ? MIN_BLOCK_SIZE - HEADER_SIZE : AlignUp(size, BLOCK_ALIGN);
+    }
+
+    uintptr_t DataBegin() const
+    {
+        return reinterpret_cast<uintptr_t>(this) + DataOffset();
+    }
+
+    uintptr_t DataEnd() const
+    {
+        return DataBegin() + DataSize();
+    }
+
+    // links of a list of pools
+    struct PoolLinks {
+        FreeListMemoryPool *next = nullptr;
+        FreeListMemoryPool *prev = nullptr;
+    };
+
+    void LinkTo(FreeListMemoryPool *&head, PoolLinks FreeListMemoryPool::*links)
+    {
+        (this->*links).next = head;
+        if (head != nullptr) {
+            (head->*links).prev = this;
+        }
+        head = this;
+    }
+
+    void UnlinkFrom(FreeListMemoryPool *&head, PoolLinks FreeListMemoryPool::*links)
+    {
+        PoolLinks &own = this->*links;
+        if (own.prev != nullptr) {
+            (own.prev->*links).next = own.next;
+        } else {
+            head = own.next;
+        }
+        if (own.next != nullptr) {
+            (own.next->*links).prev = own.prev;
+        }
+        own = PoolLinks {};
+    }
+
+    static Block *BlockOf(const void *ptr)
+    {
+        return reinterpret_cast<Block *>(reinterpret_cast<uintptr_t>(ptr) - HEADER_SIZE);
+    }
+
+    // coalesces @param block, which is not in use anymore, with free neighbours and puts it to the bins
+    void FreeBlock(Block *block)
+    {
+        Block *next = NextOf(block);
+        if (next != nullptr && next->IsFree()) {
+            RemoveFree(next);
+            SetStart(next, false);
+            block->SetSize(block->Size() + next->Size());
+        }
+        if (block->IsPrevFree()) {
+            auto *prev = reinterpret_cast<Block *>(reinterpret_cast<uintptr_t>(block) - block->prevSize);
+            RemoveFree(prev);
+            SetStart(block, false);
+            prev->SetSize(prev->Size() + block->Size());
+            block = prev;
+        }
+        SetFree(block, true);
+        InsertFree(block);
+    }
+
+    /**
+     * @brief Finds a free block for a batch of @param count blocks of @param blockSize: the best fit of the whole
+     * batch, or the largest free block if none fits it
+     * @returns nullptr if even one block does not fit
+     */
+    Block *FindBatchBlock(size_t blockSize, size_t count) const
+    {
+        if (count <= DataSize() / blockSize) {
+            LargeBlock *fit = LowerBound(count * blockSize, 0U);
+            if (fit != nullptr) {
+                return fit;
+            }
+        }
+        Block *largest = FindLargestFree();
+        return largest != nullptr && largest->Size() >= blockSize ? largest : nullptr;
+    }
+
+    // @returns the largest free block or nullptr
+    Block *FindLargestFree() const
+    {
+        if (treap_ != nullptr) {
+            LargeBlock *largest = treap_;
+            while (largest->right != nullptr) {
+                largest = largest->right;
+            }
+            return largest;
+        }
+        return binsMap_ == 0U ? nullptr : bins_[BITS_IN_WORD - 1U - static_cast<size_t>(__builtin_clzll(binsMap_))];
+    }
+
+    /**
+     * @brief Carves up to @param count blocks of @param blockSize back to back from the free @param block, which
+     * should hold at least one of them. The rest of the block goes back to the bins
+     * @returns count of blocks written to @param out
+     */
+    template <class T>
+    size_t CarveBatch(Block *block, size_t blockSize, T **out, size_t count)
+    {
+        RemoveFree(block);
+        size_t freeSize = block->Size();
+        size_t carved = freeSize / blockSize < count ? freeSize / blockSize : count;
+        auto begin = reinterpret_cast<uintptr_t>(block);
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (size_t i = 0U; i < carved; ++i) {
+            auto *used = reinterpret_cast<Block *>(begin + i * blockSize);
+            // the previous block is never free, as free neighbours are always coalesced
+            used->sizeAndFlags = blockSize;
+            SetStart(used, true);
+            out[i] = reinterpret_cast<T *>(begin + i * blockSize + HEADER_SIZE);
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto *last = reinterpret_cast<Block *>(begin + (carved - 1U) * blockSize);
+        size_t restSize = freeSize - carved * blockSize;
+        if (restSize >= MIN_BLOCK_SIZE) {
+            auto *rest = reinterpret_cast<Block *>(begin + carved * blockSize);
+            rest->sizeAndFlags = restSize;
+            SetStart(rest, true);
+            SetFree(rest, true);
+            InsertFree(rest);
+        } else {
+            last->SetSize(blockSize + restSize);
+            SetFree(last, false);
+        }
+        allocatedCount_ += carved;
+        return carved;
+    }
+
+    // tries every block of @param bin, @returns payload or nullptr
+    void *AllocateFromBin(size_t bin, size_t payloadSize, size_t align)
+    {
+        for (Block *block = bins_[bin]; block != nullptr; block = block->next) {
+            void *mem = AllocateFrom(block, payloadSize, align);
+            if (mem != nullptr) {
+                return mem;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Carves @param payloadSize bytes aligned to @param align out of the free @param block.
+     * The rest of the block goes back to the bins
+     * @returns payload or nullptr if it does not fit
+     */
+    void *AllocateFrom(Block *block, size_t payloadSize, size_t align)
+    {
+        auto begin = reinterpret_cast<uintptr_t>(block);
+        uintptr_t payload = AlignUp(begin + HEADER_SIZE, align);
+        // the gap in front of an over-aligned payload should be big enough to stay a free block
+        while (payload - HEADER_SIZE != begin && payload - HEADER_SIZE - begin < MIN_BLOCK_SIZE) {
+            payload += align;
+        }
+        size_t blockSize = block->Size();
+        if (payload + payloadSize > begin + blockSize) {
+            return nullptr;
+        }
+        RemoveFree(block);
+        auto *used = reinterpret_cast<Block *>(payload - HEADER_SIZE);
+        size_t leadSize = payload - HEADER_SIZE - begin;
+        size_t usedSize = blockSize - leadSize;
+        Block *tail = nullptr;
+        if (usedSize - HEADER_SIZE - payloadSize >= MIN_BLOCK_SIZE) {
+            tail = reinterpret_cast<Block *>(payload + payloadSize);
+            tail->sizeAndFlags = usedSize - HEADER_SIZE - payloadSize;
+            SetStart(tail, true);
+            usedSize = HEADER_SIZE + payloadSize;
+        }
+        if (leadSize != 0U) {
+            used->sizeAndFlags = usedSize;
+            block->SetSize(leadSize);
+            SetFree(block, true);
+            InsertFree(block);
+            SetStart(used, true);
+        } else {
+            // the previous block is never free, as free neighbours are always coalesced
+            used->SetSize(usedSize);
+        }
+        SetFree(used, false);
+        if (tail != nullptr) {
+            SetFree(tail, true);
+            InsertFree(tail);
+        }
+        ++allocatedCount_;
+        return reinterpret_cast<void *>(payload);
+    }
+
+    // @returns block right after @param block or nullptr if it is the last one
+    Block *NextOf(const Block *block) const
+    {
+        uintptr_t end = reinterpret_cast<uintptr_t>(block) + block->Size();
+        return end == DataEnd() ? nullptr : reinterpret_cast<Block *>(end);
+    }
+
+    // updates flags of @param block and boundary tags of the next block
+    void SetFree(Block *block, bool free)
+    {
+        block->SetFlag(Block::FREE, free);
+        Block *next = NextOf(block);
+        if (next != nullptr) {
+            next->SetFlag(Block::PREV_FREE, free);
+            next->prevSize = block->Size();
+        }
+    }
+
+    void InsertFree(Block *block)
+    {
+        if (block->Size() >= largestFree_) {
+            largestFree_ = block->Size();
+            largestFreeStale_ = false;
+        }
+        if (block->Size() >= LARGE_BLOCK_SIZE) {
+            auto *large = static_cast<LargeBlock *>(block);
+            auto [less, greater] = Split(treap_, large);
+            large->left = nullptr;
+            large->right = nullptr;
+            treap_ = Merge(Merge(less, large), greater);
+            return;
+        }
+        size_t bin = block->Size() / BLOCK_ALIGN;
+        block->prev = nullptr;
+        block->next = bins_[bin];
+        if (block->next != nullptr) {
+            block->next->prev = block;
+        }
+        bins_[bin] = block;
+        binsMap_ |= uint64_t {1U} << bin;
+    }
+
+    void RemoveFree(Block *block)
+    {
+        // another block of the same size may be left, it is found when the size is asked for
+        largestFreeStale_ |= block->Size() == largestFree_;
+        if (block->Size() >= LARGE_BLOCK_SIZE) {
+            auto *large = static_cast<LargeBlock *>(block);
+            LargeBlock **link = &treap_;
+            while (*link != large) {
+                link = Less(large, *link) ? &(*link)->left : &(*link)->right;
+            }
+            *link = Merge(large->left, large->right);
+            return;
+        }
+        size_t bin = block->Size() / BLOCK_ALIGN;
+        if (block->prev != nullptr) {
+            block->prev->next = block->next;
+        } else {
+            bins_[bin] = block->next;
+        }
+        if (block->next != nullptr) {
+            block->next->prev = block->prev;
+        }
+        if (bins_[bin] == nullptr) {
+            binsMap_ &= ~(uint64_t {1U} << bin);
+        }
+    }
+
+    // treap nodes are ordered by size, then by address
+    static bool Less(const LargeBlock *lhs, const LargeBlock *rhs)
+    {
+        return lhs->Size() != rhs->Size() ? lhs->Size() < rhs->Size() : lhs < rhs;
+    }
+
+    // heap order of the treap is given by a hash of the node address, so no random state is needed
+    static uint64_t Priority(const LargeBlock *block)
+    {
+        constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+        return (reinterpret_cast<uintptr_t>(block) / BLOCK_ALIGN) * MULTIPLIER;
+    }
+
+    // splits @param root into nodes less than @param key and nodes greater than it
+    static std::pair<LargeBlock *, LargeBlock *> Split(LargeBlock *root, const LargeBlock *key)
+    {
+        if (root == nullptr) {
+            return {nullptr, nullptr};
+        }
+        if (Less(root, key)) {
+            auto [less, greater] = Split(root->right, key);
+            root->right = less;
+            return {root, greater};
+        }
+        auto [less, greater] = Split(root->left, key);
+        root->left = greater;
+        return {less, root};
+    }
+
+    // merges treaps, all nodes of @param less should be less than nodes of @param greater
+    static LargeBlock *Merge(LargeBlock *less, LargeBlock *greater)
+    {
+        if (less == nullptr) {
+            return greater;
+        }
+        if (greater == nullptr) {
+            return less;
+        }
+        if (Priority(less) > Priority(greater)) {
+            less->right = Merge(less->right, greater);
+            return less;
+        }
+        greater->left = Merge(less, greater->left);
+        return greater;
+    }
+
+    // @returns the least large free block which is not less than (@param size, @param addr)
+    LargeBlock *LowerBound(size_t size, uintptr_t addr) const
+    {
+        LargeBlock *found = nullptr;
+        for (LargeBlock *node = treap_; node != nullptr;) {
+            size_t nodeSize = node->Size();
+            if (nodeSize > size || (nodeSize == size && reinterpret_cast<uintptr_t>(node) >= addr)) {
+                found = node;
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return found;
+    }
+
+    size_t GranuleOf(const Block *block) const
+    {
+        return (reinterpret_cast<uintptr_t>(block) - reinterpret_cast<uintptr_t>(this)) / BLOCK_ALIGN;
+    }
+
+    bool IsStart(const Block *block) const
+    {
+        size_t granule = GranuleOf(block);
+        return (starts_[granule / BITS_IN_WORD] & (uint64_t {1U} << (granule % BITS_IN_WORD))) != 0U;
+    }
+
+    void SetStart(const Block *block, bool start)
+    {
+        size_t granule = GranuleOf(block);
+        uint64_t bit = uint64_t {1U} << (granule % BITS_IN_WORD);
+        if (start) {
+            starts_[granule / BITS_IN_WORD] |= bit;
+        } else {
+            starts_[granule / BITS_IN_WORD] &= ~bit;
+        }
+    }
+
+    FreeListAllocator *owner_;
+    PoolLinks all_;
+    PoolLinks byFree_;
+    size_t freeClass_ = NOT_FILED;
+    // upper bound of free block sizes, it is exact unless stale
+    size_t largestFree_ = 0U;
+    bool largestFreeStale_ = false;
+    size_t allocatedCount_ = 0U;
+    // bit i is set if bins_[i] is not empty
+    uint64_t binsMap_ = 0U;
+    std::array<Block *, BINS_COUNT> bins_ {};
+    LargeBlock *treap_ = nullptr;
+    // one bit per BLOCK_ALIGN bytes of the pool, set for headers of all blocks. Only VerifyPtr needs it: pointers
+    // to the middle of a block can not be told from a block start by boundary tags
+    std::array<uint64_t, (GRANULES_COUNT + BITS_IN_WORD - 1U) / BITS_IN_WORD> starts_ {};
 };
 
-#endif  // MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
\ No newline at end of file
+#endif  // MEMORY_MANAGEMENT_FREE_LIST_ALLOCATOR_INCLUDE_FREE_LIST_ALLOCATOR_H
@@ -1,6 +1,18 @@
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "memory_management/common/include/stl_adapters.h"
 #include "memory_management/free_list_allocator/include/free_list_allocator.h"
 
 TEST(FreeListAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ prefix to use test
@@ -27,10 +39,382 @@ TEST(FreeListAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED
     allocator.Free(int1);
 }
 
-TEST(FreeListAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABLED_ prefix to use test
+TEST(FreeListAllocatorTest, AllocatorMemPoolOverflowTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 8U;
     FreeListAllocator<MEMORY_POOL_SIZE> allocator;
     auto *mem = allocator.Allocate<size_t>(1U);
     ASSERT_EQ(mem, nullptr);
-}
\ No newline at end of file
+}
+TEST(FreeListAllocatorTest, ReuseAndCoalescingTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    constexpr size_t COUNT = 64U;
+    auto *first = allocator.Allocate<size_t>(COUNT);
+    auto *second = allocator.Allocate<size_t>(COUNT);
+    auto *third = allocator.Allocate<size_t>(COUNT);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(third, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_FALSE(allocator.VerifyPtr(second + 1U));
+
+    allocator.Free(second);
+    ASSERT_FALSE(allocator.VerifyPtr(second));
+    ASSERT_EQ(allocator.Allocate<size_t>(COUNT), second);  // first fit reuses the freed block
+
+    allocator.Free(first);
+    allocator.Free(second);
+    // freed neighbours are merged, so a block twice as big fits in their place
+    ASSERT_EQ(allocator.Allocate<size_t>(2U * COUNT), first);
+    allocator.Free(first);
+    allocator.Free(third);
+}
+
+TEST(FreeListAllocatorTest, NewPoolTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    constexpr size_t COUNT = 512U;
+    auto *first = allocator.Allocate<char>(COUNT);
+    auto *second = allocator.Allocate<char>(COUNT);  // does not fit into the rest of the first pool
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(first));
+    ASSERT_TRUE(allocator.VerifyPtr(second));
+    ASSERT_EQ(allocator.Allocate<char>(MEMORY_POOL_SIZE), nullptr);  // bigger than any pool
+    allocator.Free(first);
+    allocator.Free(second);
+}
+
+TEST(FreeListAllocatorTest, AlignmentTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *small = allocator.Allocate<char>(1U);
+    ASSERT_NE(small, nullptr);
+    constexpr size_t AVX_ALIGN = 32U;
+    auto *avx = allocator.AllocateAligned<float>(8U, AVX_ALIGN);
+    ASSERT_NE(avx, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(avx) % AVX_ALIGN, 0U);
+    auto *line = allocator.AllocateAligned<size_t>(1U, CACHE_LINE_SIZE);
+    ASSERT_NE(line, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(line) % CACHE_LINE_SIZE, 0U);
+    ASSERT_TRUE(allocator.VerifyPtr(avx));
+    ASSERT_TRUE(allocator.VerifyPtr(line));
+    ASSERT_EQ(allocator.AllocateAligned<char>(1U, 3U), nullptr);  // alignment should be a power of two
+
+    allocator.Free(avx);
+    allocator.Free(line);
+    allocator.Free(small);
+    // everything is coalesced back, so the whole pool is available again
+    constexpr size_t BIG_COUNT = 3584U;
+    auto *big = allocator.Allocate<char>(BIG_COUNT);
+    ASSERT_EQ(big, small);
+    allocator.Free(big);
+}
+
+TEST(FreeListAllocatorTest, ManyPoolsTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4048U;
+    constexpr size_t POOLS_COUNT = 64U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    std::vector<char *> allocated;
+    for (size_t i = 0; i < POOLS_COUNT; ++i) {
+        auto *mem = allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U);  // only one of them fits into a pool
+        ASSERT_NE(mem, nullptr);
+        allocated.push_back(mem);
+    }
+    for (auto *mem : allocated) {
+        ASSERT_TRUE(allocator.VerifyPtr(mem));
+    }
+    size_t onStack = 0;
+    auto heap = std::make_unique<size_t>(0U);
+    ASSERT_FALSE(allocator.VerifyPtr(&onStack));
+    ASSERT_FALSE(allocator.VerifyPtr(heap.get()));
+    ASSERT_FALSE(allocator.VerifyPtr(nullptr));
+
+    for (auto *mem : allocated) {
+        allocator.Free(mem);
+        ASSERT_FALSE(allocator.VerifyPtr(mem));
+    }
+    for (size_t i = 0; i < POOLS_COUNT; ++i) {
+        ASSERT_NE(allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U), nullptr);
+    }
+}
+
+TEST(FreeListAllocatorTest, TrimTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4048U;
+    constexpr size_t POOLS_COUNT = 3U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    std::vector<char *> allocated;
+    for (size_t i = 0; i < POOLS_COUNT; ++i) {
+        allocated.push_back(allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U));  // one allocation per pool
+        ASSERT_NE(allocated.back(), nullptr);
+    }
+    allocator.Free(allocated[0]);
+    ASSERT_EQ(allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U), allocated[0]);  // the emptied pool is kept
+
+    allocator.Free(allocated[0]);
+    allocator.Free(allocated[1]);  // only the last emptied pool is kept
+    ASSERT_EQ(allocator.Trim(), 1U);
+    ASSERT_EQ(allocator.Trim(), 0U);
+    ASSERT_FALSE(allocator.VerifyPtr(allocated[0]));
+    ASSERT_TRUE(allocator.VerifyPtr(allocated[2]));
+
+    allocator.Free(allocated[2]);
+    ASSERT_EQ(allocator.Trim(), 1U);
+    ASSERT_NE(allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U), nullptr);
+}
+
+TEST(FreeListAllocatorTest, BatchTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t BATCH_SIZE = 500U;  // does not fit into one pool
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    std::vector<uint64_t *> batch(BATCH_SIZE);
+    ASSERT_EQ(allocator.AllocateBatch(BATCH_SIZE, batch.data()), BATCH_SIZE);
+    for (auto *mem : batch) {
+        ASSERT_TRUE(allocator.VerifyPtr(mem));
+        *mem = 0U;
+    }
+    allocator.FreeBatch(batch.data(), BATCH_SIZE);
+    for (auto *mem : batch) {
+        ASSERT_FALSE(allocator.VerifyPtr(mem));
+    }
+    // freed blocks are coalesced back, so a big block fits again
+    ASSERT_NE(allocator.Allocate<char>(MEMORY_POOL_SIZE / 2U), nullptr);
+    ASSERT_EQ(allocator.AllocateBatch(BATCH_SIZE, batch.data()), BATCH_SIZE);
+}
+
+TEST(FreeListAllocatorTest, BatchCarveTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 16U;
+    constexpr size_t BATCH_SIZE = 64U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+    auto *guard = allocator.Allocate<uint64_t>(1U);
+    ASSERT_NE(guard, nullptr);
+
+    // the whole batch is carved back to back from one free block
+    std::vector<uint64_t *> batch(BATCH_SIZE);
+    ASSERT_EQ(allocator.AllocateBatch(BATCH_SIZE, batch.data()), BATCH_SIZE);
+    auto stride = reinterpret_cast<uintptr_t>(batch[1U]) - reinterpret_cast<uintptr_t>(batch[0U]);
+    for (size_t i = 1U; i < BATCH_SIZE; ++i) {
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(batch[i]) - reinterpret_cast<uintptr_t>(batch[i - 1U]), stride);
+        ASSERT_TRUE(allocator.VerifyPtr(batch[i]));
+    }
+    // a hole in the middle splits the run, both parts are still coalesced with it
+    void *first = batch[0U];
+    allocator.Free(batch[BATCH_SIZE / 2U]);
+    batch.erase(batch.begin() + BATCH_SIZE / 2U);
+    allocator.FreeBatch(batch.data(), batch.size());
+    for (auto *mem : batch) {
+        ASSERT_FALSE(allocator.VerifyPtr(mem));
+    }
+    ASSERT_EQ(allocator.Allocate<uint8_t>(MEMORY_POOL_SIZE / 2U), first);
+}
+
+TEST(FreeListAllocatorTest, PoolsWithFreeTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t POOLS_COUNT = 4U;
+    constexpr size_t HOLE_BLOCKS = 16U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+    auto poolOf = [](const void *ptr) { return reinterpret_cast<uintptr_t>(ptr) & ~(MEMORY_POOL_SIZE - 1U); };
+
+    std::vector<uint8_t *> blocks;
+    std::set<uintptr_t> pools;
+    while (pools.size() < POOLS_COUNT) {
+        blocks.push_back(allocator.Allocate<uint8_t>(48U));
+        ASSERT_NE(blocks.back(), nullptr);
+        pools.insert(poolOf(blocks.back()));
+    }
+    // the newest pool has a big free tail, others have only small holes, and the first one has a medium hole
+    uintptr_t first = poolOf(blocks.front());
+    for (size_t i = 0U; i < blocks.size(); ++i) {
+        if (poolOf(blocks[i]) == first ? i < HOLE_BLOCKS : i % 2U == 0U) {
+            allocator.Free(blocks[i]);
+        }
+    }
+    // the pool with the least free block which holds the allocation is found without trying others
+    ASSERT_EQ(allocator.Allocate<uint8_t>(512U), blocks.front());
+    ASSERT_EQ(poolOf(allocator.Allocate<uint8_t>(2048U)), poolOf(blocks.back()));
+    // no pool holds another one
+    ASSERT_EQ(pools.count(poolOf(allocator.Allocate<uint8_t>(2048U))), 0U);
+}
+
+TEST(FreeListAllocatorTest, MixedSizesTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 16U;
+    constexpr size_t ITERATIONS = 10000U;
+    constexpr size_t MAX_SIZE = 4096U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    std::mt19937 random(0U);  // NOLINT(cert-msc51-cpp)
+    std::vector<std::pair<uint8_t *, size_t>> allocated;
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        if (!allocated.empty() && random() % 2U == 0U) {
+            size_t idx = random() % allocated.size();
+            auto [mem, size] = allocated[idx];
+            for (size_t j = 0; j < size; ++j) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                ASSERT_EQ(mem[j], static_cast<uint8_t>(size));
+            }
+            allocator.Free(mem);
+            allocated[idx] = allocated.back();
+            allocated.pop_back();
+            continue;
+        }
+        size_t size = 1U + random() % MAX_SIZE;
+        auto *mem = allocator.Allocate<uint8_t>(size);
+        ASSERT_NE(mem, nullptr);
+        ASSERT_TRUE(allocator.VerifyPtr(mem));
+        std::fill_n(mem, size, static_cast<uint8_t>(size));
+        allocated.emplace_back(mem, size);
+    }
+    for (auto [mem, size] : allocated) {
+        allocator.Free(mem);
+    }
+    // all blocks of the kept pool are coalesced back, so a big block is taken from it instead of a new pool
+    ASSERT_NE(allocator.Allocate<uint8_t>(MEMORY_POOL_SIZE - MAX_SIZE), nullptr);
+    ASSERT_EQ(allocator.Trim(), 0U);
+}
+
+TEST(FreeListAllocatorTest, CoalesceBothNeighboursTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t COUNT = 32U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    std::array<size_t *, 4U> blocks {};
+    for (auto &block : blocks) {
+        block = allocator.Allocate<size_t>(COUNT);
+        ASSERT_NE(block, nullptr);
+    }
+    allocator.Free(blocks[0]);
+    allocator.Free(blocks[2]);
+    allocator.Free(blocks[1]);  // merges with free blocks on both sides
+    // three payloads and two 16 byte headers freed by merging
+    constexpr size_t HEADERS_COUNT = 2U * 16U / sizeof(size_t);
+    ASSERT_EQ(allocator.Allocate<size_t>(3U * COUNT + HEADERS_COUNT), blocks[0]);
+    ASSERT_TRUE(allocator.VerifyPtr(blocks[3]));
+    ASSERT_FALSE(allocator.VerifyPtr(blocks[1]));
+}
+
+TEST(FreeListAllocatorTest, BestFitTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 16U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    constexpr std::array<size_t, 3U> SIZES {4000U, 1200U, 2000U};
+    std::array<char *, SIZES.size()> blocks {};
+    for (size_t i = 0; i < SIZES.size(); ++i) {
+        blocks[i] = allocator.Allocate<char>(SIZES[i]);
+        ASSERT_NE(blocks[i], nullptr);
+        ASSERT_NE(allocator.Allocate<char>(1U), nullptr);  // keeps freed blocks from coalescing
+    }
+    for (auto *block : blocks) {
+        allocator.Free(block);
+    }
+    // the smallest free block which fits is taken
+    ASSERT_EQ(allocator.Allocate<char>(1100U), blocks[1]);
+    ASSERT_EQ(allocator.Allocate<char>(1900U), blocks[2]);
+    ASSERT_EQ(allocator.Allocate<char>(1200U), blocks[0]);
+}
+
+TEST(FreeListAllocatorTest, ReallocateTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t COUNT = 64U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *mem = allocator.Allocate<uint32_t>(COUNT);
+    ASSERT_NE(mem, nullptr);
+    std::iota(mem, mem + COUNT, 0U);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    // the rest of the pool is free, so the block grows in place
+    ASSERT_EQ(allocator.Reallocate(mem, 4U * COUNT), mem);
+    // shrinking gives the tail back
+    ASSERT_EQ(allocator.Reallocate(mem, COUNT), mem);
+    auto *next = allocator.Allocate<uint32_t>(COUNT);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_LT(next, mem + 2U * COUNT);
+
+    // the next block is allocated, so the memory moves
+    auto *moved = allocator.Reallocate(mem, 2U * COUNT);
+    ASSERT_NE(moved, nullptr);
+    ASSERT_NE(moved, mem);
+    ASSERT_FALSE(allocator.VerifyPtr(mem));
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(moved[i], i);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    ASSERT_EQ(allocator.Reallocate(moved, MEMORY_POOL_SIZE), nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(moved));
+    allocator.Free(moved);
+    allocator.Free(next);
+}
+
+TEST(FreeListAllocatorTest, BufferPageSourceTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t POOLS_COUNT = 4U;
+    constexpr size_t COUNT = MEMORY_POOL_SIZE / 2U;
+    std::vector<uint8_t> buffer((POOLS_COUNT + 1U) * MEMORY_POOL_SIZE);
+    FreeListAllocator<MEMORY_POOL_SIZE, BufferPageSource> allocator(BufferPageSource(buffer.data(), buffer.size()));
+
+    // every pool holds one allocation of the half of the pool
+    std::vector<uint8_t *> mems;
+    for (uint8_t *mem = allocator.Allocate(COUNT); mem != nullptr; mem = allocator.Allocate(COUNT)) {
+        ASSERT_GE(mem, buffer.data());
+        ASSERT_LT(mem, buffer.data() + buffer.size());
+        mems.push_back(mem);
+    }
+    ASSERT_GE(mems.size(), POOLS_COUNT);
+    for (uint8_t *mem : mems) {
+        allocator.Free(mem);
+    }
+    allocator.Trim();
+    // memory of released pools is reused by new ones
+    for (size_t i = 0; i < mems.size(); ++i) {
+        ASSERT_NE(allocator.Allocate(COUNT), nullptr);
+    }
+    ASSERT_EQ(allocator.Allocate(COUNT), nullptr);
+}
+
+TEST(FreeListAllocatorTest, MemoryResourceTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 16U;
+    constexpr size_t COUNT = 1000U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+    {
+        AllocatorMemoryResource resource(allocator);
+        std::pmr::unordered_map<size_t, std::pmr::string> map(&resource);
+        for (size_t i = 0; i < COUNT; ++i) {
+            map.emplace(i, std::pmr::string(i % 64U, 'a', &resource));
+        }
+        for (size_t i = 0; i < COUNT; i += 2U) {
+            map.erase(i);
+        }
+        ASSERT_EQ(map.size(), COUNT / 2U);
+        ASSERT_EQ(map.at(1U), "a");
+        ASSERT_EQ(map.count(2U), 0U);
+        ASSERT_EQ(map.get_allocator().resource(), &resource);
+    }
+    // containers give all memory back
+    ASSERT_EQ(allocator.Trim(), 1U);
+
+    using Allocator = StlAllocator<size_t, decltype(allocator)>;
+    std::vector<size_t, Allocator> values {Allocator(allocator)};
+    values.resize(COUNT);
+    ASSERT_TRUE(allocator.VerifyPtr(values.data()));
+    ASSERT_THROW(values.resize(MEMORY_POOL_SIZE), std::bad_alloc);
+    ASSERT_EQ(values.size(), COUNT);
+}
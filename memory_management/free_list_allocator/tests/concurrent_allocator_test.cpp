@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "memory_management/common/include/node_local_allocator.h"
+#include "memory_management/free_list_allocator/include/concurrent_free_list_allocator.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+
+TEST(ConcurrentFreeListAllocatorTest, SingleThreadTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    ConcurrentFreeListAllocator<MEMORY_POOL_SIZE, 4U> allocator;
+
+    auto *mem = allocator.Allocate<size_t>(16U);
+    ASSERT_NE(mem, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(mem));
+    size_t onStack = 0;
+    ASSERT_FALSE(allocator.VerifyPtr(&onStack));
+    allocator.Free(mem);
+    ASSERT_FALSE(allocator.VerifyPtr(mem));
+    ASSERT_EQ(allocator.Allocate<size_t>(16U), mem);
+    ASSERT_EQ(allocator.Allocate<char>(MEMORY_POOL_SIZE), nullptr);
+}
+
+TEST(ConcurrentFreeListAllocatorTest, CrossThreadFreeTest)
+{
+    constexpr size_t THREADS_COUNT = 8U;
+    constexpr size_t ALLOCS_PER_THREAD = 2000U;
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 14U;
+    using Allocator = ConcurrentFreeListAllocator<MEMORY_POOL_SIZE, 4U>;
+    Allocator allocator;
+
+    std::array<std::vector<size_t *>, THREADS_COUNT> allocated;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            for (size_t j = 0; j < ALLOCS_PER_THREAD; ++j) {
+                auto *mem = allocator.Allocate<size_t>(1U + j % 64U);
+                ASSERT_NE(mem, nullptr);
+                *mem = i;
+                ptrs.push_back(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    std::vector<size_t *> all;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        for (auto *mem : allocated[i]) {
+            ASSERT_EQ(*mem, i);
+            all.push_back(mem);
+        }
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+
+    // every thread frees memory allocated by its neighbour and allocates at the same time
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&allocator, &ptrs = allocated[(i + 1U) % THREADS_COUNT]]() {
+            for (auto *mem : ptrs) {
+                allocator.Free(mem);
+                allocator.Free(allocator.Allocate<size_t>(1U));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto *mem : all) {
+        ASSERT_FALSE(allocator.VerifyPtr(mem));
+    }
+    ASSERT_NE(allocator.Trim(), 0U);
+}
+
+TEST(ConcurrentFreeListAllocatorTest, IdleOwnerTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 13U;
+    constexpr size_t POOLS_COUNT = 4U;
+    constexpr size_t BLOCK_SIZE = 64U;
+    // the allocator type is used only here, so this thread takes the first shard and the other thread the second one
+    ConcurrentFreeListAllocator<MEMORY_POOL_SIZE, 2U> allocator;
+    allocator.Free(allocator.Allocate(1U));
+
+    std::vector<uint8_t *> allocated;
+    std::thread owner([&allocator, &allocated]() {
+        for (size_t i = 0; i < POOLS_COUNT * MEMORY_POOL_SIZE / BLOCK_SIZE; ++i) {
+            auto *mem = allocator.Allocate(BLOCK_SIZE);
+            ASSERT_NE(mem, nullptr);
+            allocated.push_back(mem);
+        }
+    });
+    owner.join();
+
+    // the owner never allocates again, the frees still empty its pools and only one of them is kept
+    for (auto *mem : allocated) {
+        allocator.Free(mem);
+    }
+    for (auto *mem : allocated) {
+        ASSERT_FALSE(allocator.GetShardAllocator(1U).VerifyPtr(mem));
+    }
+    ASSERT_EQ(allocator.Trim(), 2U);
+}
+
+TEST(NodeLocalAllocatorTest, CrossThreadFreeTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    constexpr size_t ALLOCS_PER_THREAD = 1000U;
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 14U;
+    NodeLocalAllocator<FreeListAllocator<MEMORY_POOL_SIZE, NumaPageSource>> allocator;
+
+    // memory of the calling thread node is used first
+    auto *mem = allocator.Allocate<size_t>(16U);
+    ASSERT_NE(mem, nullptr);
+    ASSERT_TRUE(allocator.GetNodeAllocator(CurrentNumaNode()).VerifyPtr(mem));
+    allocator.Free(mem);
+    ASSERT_FALSE(allocator.VerifyPtr(mem));
+
+    std::array<std::vector<size_t *>, THREADS_COUNT> allocated;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            for (size_t j = 0; j < ALLOCS_PER_THREAD; ++j) {
+                auto *ptr = allocator.Allocate<size_t>(1U + j % 32U);
+                ASSERT_NE(ptr, nullptr);
+                *ptr = i;
+                ptrs.push_back(ptr);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&allocator, &ptrs = allocated[(i + 1U) % THREADS_COUNT], i]() {
+            for (auto *ptr : ptrs) {
+                ASSERT_EQ(*ptr, (i + 1U) % THREADS_COUNT);
+                allocator.Free(ptr);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto &ptrs : allocated) {
+        for (auto *ptr : ptrs) {
+            ASSERT_FALSE(allocator.VerifyPtr(ptr));
+        }
+    }
+    ASSERT_NE(allocator.Trim(), 0U);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+
+#ifndef ALLOCATOR_STATS
+#error "statistics tests should be built with ALLOCATOR_STATS"
+#endif
+
+TEST(FreeListAllocatorStatsTest, GetStatsTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t COUNT = 32U;
+    FreeListAllocator<MEMORY_POOL_SIZE> allocator;
+
+    auto *first = allocator.Allocate<uint64_t>(COUNT);
+    auto *second = allocator.Allocate<uint64_t>(COUNT);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(allocator.Allocate<uint8_t>(MEMORY_POOL_SIZE), nullptr);
+    AllocatorStats stats = allocator.GetStats();
+    ASSERT_EQ(stats.allocations, 2U);
+    ASSERT_EQ(stats.failures, 1U);
+    ASSERT_EQ(stats.poolsCount, 1U);
+    ASSERT_EQ(stats.liveBytes, 2U * COUNT * sizeof(uint64_t));
+    ASSERT_EQ(stats.largestFreeBlock, stats.freeBytes);
+    ASSERT_EQ(stats.fragmentation, 0.0);
+    ASSERT_GT(stats.reservedBytes, MEMORY_POOL_SIZE);
+
+    // a hole in front of the allocated block
+    allocator.Free(first);
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.frees, 1U);
+    ASSERT_EQ(stats.liveBytes, COUNT * sizeof(uint64_t));
+    ASSERT_GT(stats.fragmentation, 0.0);
+    ASSERT_LT(stats.largestFreeBlock, stats.freeBytes);
+}
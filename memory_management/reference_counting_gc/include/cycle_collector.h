@@ -0,0 +1,336 @@
+#ifndef MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_CYCLE_COLLECTOR_H
+#define MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_CYCLE_COLLECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "base/macros.h"
+#include "memory_management/reference_counting_gc/include/object_module.h"
+
+/**
+ * @brief Reference count of objects collected by CycleCollector. Like NonAtomicRefCount it is for objects used by
+ * one thread. A decrement which does not destroy the object makes it a possible root of a garbage cycle, so it is
+ * buffered by the collector of the thread. Objects without VisitReferences() can not be a part of a cycle and are
+ * never buffered
+ */
+class CycleCollectedRefCount {
+public:
+    void Acquire()
+    {
+        ++count_;
+        // an object referenced again is alive
+        color_ = Color::BLACK;
+    }
+
+    bool Release();
+
+    size_t UseCount() const
+    {
+        return count_;
+    }
+
+private:
+    // colors of the synchronous cycle collection by Bacon and Rajan
+    enum class Color : uint8_t {
+        // alive or not checked
+        BLACK,
+        // possible root of a garbage cycle
+        PURPLE,
+        // its count is decremented by references from others checked ones
+        GRAY,
+        // garbage
+        WHITE,
+        // garbage which is being destroyed
+        COLLECTED,
+    };
+
+    static constexpr size_t NOT_BUFFERED = SIZE_MAX;
+
+    size_t count_ = 1U;
+    // index in the buffer of possible roots
+    size_t rootIndex_ = NOT_BUFFERED;
+    Color color_ = Color::BLACK;
+
+    friend class CycleCollector;
+};
+
+/**
+ * @brief Synchronous Bacon-Rajan cycle collector (trial deletion) of objects with CycleCollectedRefCount. Every thread
+ * has its own collector, which buffers possible roots of cycles on decrements and checks them in batches: the
+ * counts of objects reachable from the roots are decremented by their internal references and the objects which
+ * are left without references are garbage. References of garbage objects are cleared before their destruction, so
+ * their destructors do not see other objects of the cycle. Objects are traversed iteratively, so long chains are
+ * not a problem for the stack, but the time of a batch depends on the count of objects reachable from its roots.
+ * A batch is collected when the buffer grows to the threshold set by SetCollectThreshold() or by Collect()
+ */
+class CycleCollector {
+    using Block = ObjectBlock<CycleCollectedRefCount>;
+    using Color = CycleCollectedRefCount::Color;
+
+public:
+    static constexpr size_t DEFAULT_BATCH_SIZE = 256U;
+    static constexpr size_t DEFAULT_COLLECT_THRESHOLD = 4096U;
+
+    CycleCollector() = default;
+    ~CycleCollector()
+    {
+        while (!roots_.empty()) {
+            Collect(roots_.size());
+        }
+        IsFinished() = true;
+    }
+    NO_COPY_SEMANTIC(CycleCollector);
+    NO_MOVE_SEMANTIC(CycleCollector);
+
+    // @returns the collector of the calling thread
+    static CycleCollector &Current()
+    {
+        thread_local CycleCollector collector;
+        return collector;
+    }
+
+    /**
+     * @brief Checks up to @param maxRoots possible roots, the latest buffered first, and destroys the garbage cycles
+     * reachable from them
+     * @returns count of destroyed objects
+     */
+    size_t Collect(size_t maxRoots = DEFAULT_BATCH_SIZE)
+    {
+        // destructors of garbage may release other objects, which are checked by the next batch
+        if (collecting_) {
+            return 0U;
+        }
+        collecting_ = true;
+        TakeRoots(maxRoots);
+        MarkRoots();
+        ScanRoots();
+        size_t collected = CollectRoots();
+        collecting_ = false;
+        return collected;
+    }
+
+    // @returns count of possible roots waiting to be checked
+    size_t GetRootsCount() const
+    {
+        return roots_.size();
+    }
+
+    /**
+     * @brief Sets count of buffered roots which makes the collector check a batch of DEFAULT_BATCH_SIZE roots,
+     * 0 turns the automatic collection off
+     */
+    void SetCollectThreshold(size_t threshold)
+    {
+        collectThreshold_ = threshold;
+    }
+
+private:
+    friend class CycleCollectedRefCount;
+
+    // set when the collector of the thread is destroyed, objects released after that are not checked
+    static bool &IsFinished()
+    {
+        thread_local bool finished = false;
+        return finished;
+    }
+
+    void AddRoot(CycleCollectedRefCount *root)
+    {
+        root->rootIndex_ = roots_.size();
+        roots_.push_back(root);
+        if (collectThreshold_ != 0U && roots_.size() >= collectThreshold_) {
+            Collect();
+        }
+    }
+
+    void RemoveRoot(CycleCollectedRefCount *root)
+    {
+        roots_.back()->rootIndex_ = root->rootIndex_;
+        roots_[root->rootIndex_] = roots_.back();
+        roots_.pop_back();
+        root->rootIndex_ = CycleCollectedRefCount::NOT_BUFFERED;
+    }
+
+    static Block *BlockOf(CycleCollectedRefCount *count)
+    {
+        return static_cast<Block *>(count);
+    }
+
+    void TakeRoots(size_t maxRoots)
+    {
+        batch_.clear();
+        while (batch_.size() < maxRoots && !roots_.empty()) {
+            Block *root = BlockOf(roots_.back());
+            RemoveRoot(root);
+            // roots referenced again after the decrement are alive
+            if (root->color_ == Color::PURPLE) {
+                batch_.push_back(root);
+            }
+        }
+    }
+
+    // decrements counts by the internal references of the objects reachable from the roots
+    void MarkRoots()
+    {
+        for (Block *root : batch_) {
+            // a root reachable from other root is already marked
+            if (root->color_ != Color::PURPLE) {
+                continue;
+            }
+            root->color_ = Color::GRAY;
+            stack_.push_back(root);
+            while (!stack_.empty()) {
+                Block *block = stack_.back();
+                stack_.pop_back();
+                block->VisitReferences(&MarkGray, this);
+            }
+        }
+    }
+
+    static void MarkGray(Block **ref, void *context)
+    {
+        Block *block = *ref;
+        --block->count_;
+        if (block->color_ != Color::GRAY) {
+            block->color_ = Color::GRAY;
+            static_cast<CycleCollector *>(context)->stack_.push_back(block);
+        }
+    }
+
+    // objects referenced from outside and objects reachable from them are alive, others are garbage
+    void ScanRoots()
+    {
+        for (Block *root : batch_) {
+            stack_.push_back(root);
+            while (!stack_.empty()) {
+                Block *block = stack_.back();
+                stack_.pop_back();
+                if (block->color_ != Color::GRAY) {
+                    continue;
+                }
+                if (block->count_ > 0U) {
+                    ScanBlack(block);
+                } else {
+                    block->color_ = Color::WHITE;
+                    block->VisitReferences(&PushReference, this);
+                }
+            }
+        }
+    }
+
+    static void PushReference(Block **ref, void *context)
+    {
+        static_cast<CycleCollector *>(context)->stack_.push_back(*ref);
+    }
+
+    // restores counts decremented by the alive @param block and the objects reachable from it
+    void ScanBlack(Block *block)
+    {
+        // it has its own stack, the stack of the scan is not finished
+        block->color_ = Color::BLACK;
+        blackStack_.push_back(block);
+        while (!blackStack_.empty()) {
+            Block *alive = blackStack_.back();
+            blackStack_.pop_back();
+            alive->VisitReferences(&MarkBlack, this);
+        }
+    }
+
+    static void MarkBlack(Block **ref, void *context)
+    {
+        Block *block = *ref;
+        ++block->count_;
+        if (block->color_ != Color::BLACK) {
+            block->color_ = Color::BLACK;
+            static_cast<CycleCollector *>(context)->blackStack_.push_back(block);
+        }
+    }
+
+    // destroys the garbage, @returns count of destroyed objects
+    size_t CollectRoots()
+    {
+        garbage_.clear();
+        for (Block *root : batch_) {
+            if (root->color_ != Color::WHITE) {
+                continue;
+            }
+            root->color_ = Color::COLLECTED;
+            stack_.push_back(root);
+            while (!stack_.empty()) {
+                Block *block = stack_.back();
+                stack_.pop_back();
+                garbage_.push_back(block);
+                block->VisitReferences(&MarkCollected, this);
+            }
+        }
+        // counts of the garbage are restored and held, so clearing of the references does not destroy it
+        for (Block *block : garbage_) {
+            if (block->rootIndex_ != CycleCollectedRefCount::NOT_BUFFERED) {
+                RemoveRoot(block);
+            }
+            ++block->count_;
+            block->VisitReferences(&RestoreCount, nullptr);
+        }
+        for (Block *block : garbage_) {
+            block->VisitReferences(&ClearReference, nullptr);
+        }
+        size_t collected = garbage_.size();
+        for (Block *block : garbage_) {
+            block->color_ = Color::BLACK;
+            block->Release();
+        }
+        garbage_.clear();
+        return collected;
+    }
+
+    static void MarkCollected(Block **ref, void *context)
+    {
+        Block *block = *ref;
+        if (block->color_ == Color::WHITE) {
+            block->color_ = Color::COLLECTED;
+            static_cast<CycleCollector *>(context)->stack_.push_back(block);
+        }
+    }
+
+    static void RestoreCount(Block **ref, [[maybe_unused]] void *context)
+    {
+        ++(*ref)->count_;
+    }
+
+    static void ClearReference(Block **ref, [[maybe_unused]] void *context)
+    {
+        Block *block = *ref;
+        *ref = nullptr;
+        block->Release();
+    }
+
+    // possible roots of garbage cycles
+    std::vector<CycleCollectedRefCount *> roots_;
+    // roots checked by the current batch
+    std::vector<Block *> batch_;
+    std::vector<Block *> stack_;
+    std::vector<Block *> blackStack_;
+    std::vector<Block *> garbage_;
+    size_t collectThreshold_ = DEFAULT_COLLECT_THRESHOLD;
+    bool collecting_ = false;
+};
+
+inline bool CycleCollectedRefCount::Release()
+{
+    if (--count_ == 0U) {
+        if (rootIndex_ != NOT_BUFFERED) {
+            CycleCollector::Current().RemoveRoot(this);
+        }
+        return true;
+    }
+    // the garbage being destroyed is not a root
+    if (color_ == Color::BLACK && CycleCollector::BlockOf(this)->HasReferences()) {
+        color_ = Color::PURPLE;
+        if (rootIndex_ == NOT_BUFFERED && LIKELY(!CycleCollector::IsFinished())) {
+            CycleCollector::Current().AddRoot(this);
+        }
+    }
+    return false;
+}
+
+#endif  // MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_CYCLE_COLLECTOR_H
@@ -0,0 +1,169 @@
+#ifndef MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_DEFERRED_RELEASE_H
+#define MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_DEFERRED_RELEASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "base/macros.h"
+#include "memory_management/reference_counting_gc/include/object_module.h"
+
+/**
+ * @brief Reference count of objects destroyed by ReleaseQueue. Like NonAtomicRefCount it is for objects used by one
+ * thread, but an object left without references is queued to the queue of the thread instead of being destroyed.
+ * Its destruction releases the objects it refers to, which are queued too, so a long chain is destroyed
+ * iteratively. Creation of an object destroys a few queued ones, see ReleaseQueue::SetAllocationBudget()
+ */
+class DeferredRefCount {
+public:
+    DeferredRefCount();
+    ~DeferredRefCount() = default;
+    NO_COPY_SEMANTIC(DeferredRefCount);
+    NO_MOVE_SEMANTIC(DeferredRefCount);
+
+    void Acquire()
+    {
+        ++count_;
+    }
+
+    bool Release();
+
+    size_t UseCount() const
+    {
+        return count_;
+    }
+
+private:
+    // a queued object has no references, so the count keeps the link of the queue
+    union {
+        size_t count_ = 1U;
+        DeferredRefCount *nextReleased_;
+    };
+
+    friend class ReleaseQueue;
+};
+
+/**
+ * @brief Queue of objects with DeferredRefCount left without references. Every thread has its own queue, objects
+ * are destroyed in slices of a given count of objects by Drain(), DrainReleases() or on creation of new objects, so
+ * a release of a large structure does not make one long pause. Memory of queued objects is not freed till they are
+ * destroyed. The queue is drained completely on the thread exit
+ */
+class ReleaseQueue {
+    using Block = ObjectBlock<DeferredRefCount>;
+
+public:
+    static constexpr size_t DEFAULT_ALLOCATION_BUDGET = 4U;
+
+    ReleaseQueue() = default;
+    ~ReleaseQueue()
+    {
+        Drain(SIZE_MAX);
+        IsFinished() = true;
+    }
+    NO_COPY_SEMANTIC(ReleaseQueue);
+    NO_MOVE_SEMANTIC(ReleaseQueue);
+
+    // @returns the queue of the calling thread
+    static ReleaseQueue &Current()
+    {
+        thread_local ReleaseQueue queue;
+        return queue;
+    }
+
+    /**
+     * @brief Destroys up to @param budget queued objects, the latest queued first.
+     * Objects released by their destructors are queued and may be destroyed by the same call
+     * @returns count of destroyed objects
+     */
+    size_t Drain(size_t budget)
+    {
+        // destructors may create objects, which drain the queue too
+        if (draining_) {
+            return 0U;
+        }
+        draining_ = true;
+        size_t destroyed = 0U;
+        while (destroyed < budget && head_ != nullptr) {
+            auto *block = static_cast<Block *>(head_);
+            head_ = head_->nextReleased_;
+            --pendingCount_;
+            block->type_->destroy(block);
+            ++destroyed;
+        }
+        draining_ = false;
+        return destroyed;
+    }
+
+    // @returns count of objects waiting for destruction
+    size_t GetPendingCount() const
+    {
+        return pendingCount_;
+    }
+
+    /**
+     * @brief Sets count of queued objects destroyed on creation of every object with DeferredRefCount,
+     * 0 leaves them to Drain()
+     */
+    void SetAllocationBudget(size_t budget)
+    {
+        allocationBudget_ = budget;
+    }
+
+private:
+    friend class DeferredRefCount;
+
+    // set when the queue of the thread is destroyed, objects released after that are destroyed at once
+    static bool &IsFinished()
+    {
+        thread_local bool finished = false;
+        return finished;
+    }
+
+    void Push(DeferredRefCount *released)
+    {
+        released->nextReleased_ = head_;
+        head_ = released;
+        ++pendingCount_;
+    }
+
+    void DrainOnAllocation()
+    {
+        if (head_ != nullptr) {
+            Drain(allocationBudget_);
+        }
+    }
+
+    DeferredRefCount *head_ = nullptr;
+    size_t pendingCount_ = 0U;
+    size_t allocationBudget_ = DEFAULT_ALLOCATION_BUDGET;
+    bool draining_ = false;
+};
+
+inline DeferredRefCount::DeferredRefCount()
+{
+    if (LIKELY(!ReleaseQueue::IsFinished())) {
+        ReleaseQueue::Current().DrainOnAllocation();
+    }
+}
+
+inline bool DeferredRefCount::Release()
+{
+    if (--count_ != 0U) {
+        return false;
+    }
+    if (UNLIKELY(ReleaseQueue::IsFinished())) {
+        return true;
+    }
+    ReleaseQueue::Current().Push(this);
+    return false;
+}
+
+/**
+ * @brief Destroys up to @param budget objects queued to the release queue of the calling thread
+ * @returns count of destroyed objects
+ */
+inline size_t DrainReleases(size_t budget = SIZE_MAX)
+{
+    return ReleaseQueue::Current().Drain(budget);
+}
+
+#endif  // MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_DEFERRED_RELEASE_H
@@ -2,64 +2,396 @@
 #define MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODEL_H
 
 #include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "base/macros.h"
+#include "memory_management/common/include/allocator_traits.h"
+#include "memory_management/reference_counting_gc/include/ref_count.h"
 
-template <class T>
+template <class T, class RefCount = NonAtomicRefCount>
 class Object;
+template <class T, class RefCount>
+class ObjectRef;
+template <class T, class RefCount>
+class WeakObject;
 
-template <class T, class... Args>
-static Object<T> MakeObject([[maybe_unused]] Args... args)
+/**
+ * @brief Control block of an object: the reference count of policy RefCount (see ref_count.h) and the type of the
+ * object, which tells how to destroy it together with the block and how to visit its references. It does not depend
+ * on the object type, so every block can be handled without knowing it.
+ * An object type T takes part in tracing (e.g. by CycleCollector) if it has
+ *   template <class Visitor> void VisitReferences(Visitor &&visitor)
+ * calling visitor(ref) for every Object<U, RefCount> &ref it holds
+ */
+template <class RefCount>
+class ObjectBlock : public RefCount {
+public:
+    // called for every reference of an object with the pointer to the block of the reference
+    using VisitFn = void (*)(ObjectBlock **ref, void *context);
+
+    struct Type {
+        // destroys the object and frees the block
+        void (*destroy)(ObjectBlock *block);
+        // destroy only the object and only free the block, for blocks kept by weak references
+        void (*destroyObject)(ObjectBlock *block);
+        void (*free)(ObjectBlock *block);
+        // visits references of the object, nullptr if the object has no VisitReferences()
+        void (*visitReferences)(void *object, VisitFn visit, void *context);
+    };
+
+    ObjectBlock(void *object, const Type *type) : object_(object), type_(type) {}
+    ~ObjectBlock() = default;
+    NO_COPY_SEMANTIC(ObjectBlock);
+    NO_MOVE_SEMANTIC(ObjectBlock);
+
+    // drops one reference and destroys the object with the block when it was the last one
+    void Release()
+    {
+        if (RefCount::Release()) {
+            if constexpr (HAS_WEAK_COUNT<RefCount>) {
+                // the block is freed when the object is destroyed and the weak references are released
+                type_->destroyObject(this);
+                ReleaseWeak();
+            } else {
+                type_->destroy(this);
+            }
+        }
+    }
+
+    // drops one weak reference and frees the block if it was the last one
+    void ReleaseWeak()
+    {
+        if (RefCount::ReleaseWeak()) {
+            type_->free(this);
+        }
+    }
+
+    void *GetObject() const
+    {
+        return object_;
+    }
+
+    bool HasReferences() const
+    {
+        return type_->visitReferences != nullptr;
+    }
+
+    // calls @param visit for every not empty reference of the object, the reference may be changed by it
+    void VisitReferences(VisitFn visit, void *context)
+    {
+        if (HasReferences()) {
+            type_->visitReferences(object_, visit, context);
+        }
+    }
+
+    // @returns the visitor of references of T or nullptr if T does not have them
+    template <class T>
+    static constexpr auto VisitReferencesFn()
+    {
+        using Fn = void (*)(void *object, VisitFn visit, void *context);
+        if constexpr (decltype(HasVisitReferences<T>(0))::value) {
+            return static_cast<Fn>(&VisitReferencesOf<T>);
+        } else {
+            return static_cast<Fn>(nullptr);
+        }
+    }
+
+private:
+    struct ReferenceVisitor {
+        template <class U>
+        void operator()(Object<U, RefCount> &ref) const
+        {
+            if (ref.block_ != nullptr) {
+                visit(&ref.block_, context);
+            }
+        }
+
+        VisitFn visit;
+        void *context;
+    };
+
+    template <class T>
+    static auto HasVisitReferences(int)
+        -> decltype(std::declval<T &>().VisitReferences(std::declval<const ReferenceVisitor &>()), std::true_type());
+    template <class T>
+    static std::false_type HasVisitReferences(...);
+
+    template <class T>
+    static void VisitReferencesOf(void *object, VisitFn visit, void *context)
+    {
+        static_cast<T *>(object)->VisitReferences(ReferenceVisitor {visit, context});
+    }
+
+    void *object_;
+    const Type *type_;
+
+    friend class BiasedRefCount;
+    friend class ReleaseQueue;
+};
+
+inline void BiasedRefCount::MergeList(BiasedRefCount *list)
+{
+    while (list != nullptr) {
+        // the object may be destroyed by the merge
+        BiasedRefCount *next = list->nextQueued_;
+        if (list->MergeDequeued()) {
+            auto *block = static_cast<ObjectBlock<BiasedRefCount> *>(list);
+            block->type_->destroy(block);
+        }
+        list = next;
+    }
+}
+
+/**
+ * @brief Block created by MakeObject(): the object is placed right after the header, so both take one allocation
+ * and the object is on the same cache line as its count
+ */
+template <class T, class RefCount>
+class InlineObjectBlock : public ObjectBlock<RefCount> {
+public:
+    template <class... Args>
+    explicit InlineObjectBlock(Args &&...args)
+        : ObjectBlock<RefCount>(&object_, &TYPE), object_(std::forward<Args>(args)...)
+    {
+    }
+    // the object is destroyed before the block
+    ~InlineObjectBlock() {}  // NOLINT(modernize-use-equals-default)
+    NO_COPY_SEMANTIC(InlineObjectBlock);
+    NO_MOVE_SEMANTIC(InlineObjectBlock);
+
+private:
+    static void Destroy(ObjectBlock<RefCount> *block)
+    {
+        DestroyObject(block);
+        Free(block);
+    }
+
+    static void DestroyObject(ObjectBlock<RefCount> *block)
+    {
+        static_cast<InlineObjectBlock *>(block)->object_.~T();
+    }
+
+    static void Free(ObjectBlock<RefCount> *block)
+    {
+        delete static_cast<InlineObjectBlock *>(block);
+    }
+
+    static constexpr typename ObjectBlock<RefCount>::Type TYPE {
+        &Destroy, &DestroyObject, &Free, ObjectBlock<RefCount>::template VisitReferencesFn<T>()};
+
+    // the object may be destroyed while weak references keep the block
+    union {
+        T object_;
+    };
+};
+
+// Block of an object allocated by the user and passed to Object(T *) or Reset(T *)
+template <class T, class RefCount>
+class PointerObjectBlock : public ObjectBlock<RefCount> {
+public:
+    explicit PointerObjectBlock(T *ptr) : ObjectBlock<RefCount>(ptr, &TYPE) {}
+    ~PointerObjectBlock() = default;
+    NO_COPY_SEMANTIC(PointerObjectBlock);
+    NO_MOVE_SEMANTIC(PointerObjectBlock);
+
+private:
+    static void Destroy(ObjectBlock<RefCount> *block)
+    {
+        DestroyObject(block);
+        Free(block);
+    }
+
+    static void DestroyObject(ObjectBlock<RefCount> *block)
+    {
+        delete static_cast<T *>(block->GetObject());
+    }
+
+    static void Free(ObjectBlock<RefCount> *block)
+    {
+        delete static_cast<PointerObjectBlock *>(block);
+    }
+
+    static constexpr typename ObjectBlock<RefCount>::Type TYPE {
+        &Destroy, &DestroyObject, &Free, ObjectBlock<RefCount>::template VisitReferencesFn<T>()};
+};
+
+/**
+ * @brief Block created by AllocateObject(): like InlineObjectBlock, but the memory is taken from Allocator,
+ * e.g. a size class of RunOfSlotsAllocator or a BumpPointerAllocator arena. The allocator should outlive the object.
+ * If Allocator can not free memory one by one, the memory stays allocated till the allocator is reset
+ */
+template <class T, class RefCount, class Allocator>
+class AllocatorObjectBlock : public ObjectBlock<RefCount> {
+public:
+    template <class... Args>
+    explicit AllocatorObjectBlock(Allocator &allocator, Args &&...args)
+        : ObjectBlock<RefCount>(&object_, &TYPE),
+          allocator_(allocator),
+          object_(std::forward<Args>(args)...)
+    {
+    }
+    // the object is destroyed before the block
+    ~AllocatorObjectBlock() {}  // NOLINT(modernize-use-equals-default)
+    NO_COPY_SEMANTIC(AllocatorObjectBlock);
+    NO_MOVE_SEMANTIC(AllocatorObjectBlock);
+
+    // @returns memory for a block or nullptr if there is no memory
+    static void *AllocateMemory(Allocator &allocator)
+    {
+        // size class of a slot allocator is chosen at compile time
+        if constexpr (CAN_ALLOCATE_ONE<Allocator, AllocatorObjectBlock>) {
+            return allocator.template Allocate<AllocatorObjectBlock>();
+        } else {
+            return allocator.template AllocateAligned<AllocatorObjectBlock>(1U, alignof(AllocatorObjectBlock));
+        }
+    }
+
+private:
+    static void Destroy(ObjectBlock<RefCount> *block)
+    {
+        DestroyObject(block);
+        Free(block);
+    }
+
+    static void DestroyObject(ObjectBlock<RefCount> *block)
+    {
+        static_cast<AllocatorObjectBlock *>(block)->object_.~T();
+    }
+
+    static void Free(ObjectBlock<RefCount> *block)
+    {
+        auto *self = static_cast<AllocatorObjectBlock *>(block);
+        Allocator &allocator = self->allocator_;
+        self->~AllocatorObjectBlock();
+        if constexpr (CAN_FREE_ONE<Allocator>) {
+            allocator.Free(self);
+        }
+    }
+
+    static constexpr typename ObjectBlock<RefCount>::Type TYPE {
+        &Destroy, &DestroyObject, &Free, ObjectBlock<RefCount>::template VisitReferencesFn<T>()};
+
+    Allocator &allocator_;
+    // the object may be destroyed while weak references keep the block
+    union {
+        T object_;
+    };
+};
+
+/**
+ * @brief Creates T from @param args in one allocation with its control block, like std::make_shared
+ */
+template <class T, class RefCount = NonAtomicRefCount, class... Args>
+Object<T, RefCount> MakeObject(Args &&...args)
+{
+    return Object<T, RefCount>(new InlineObjectBlock<T, RefCount>(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Creates T from @param args in one block taken from @param allocator, like std::allocate_shared.
+ * Allocator should provide Allocate<T>() or AllocateAligned<T>(count, align) and may provide Free(void *)
+ * @returns new object or empty Object if the allocator is out of memory
+ */
+template <class T, class RefCount = NonAtomicRefCount, class Allocator, class... Args>
+Object<T, RefCount> AllocateObject(Allocator &allocator, Args &&...args)
 {
-    // TODO(you): Implemet this finction
-    return {};
+    using Block = AllocatorObjectBlock<T, RefCount, Allocator>;
+    void *mem = Block::AllocateMemory(allocator);
+    if (UNLIKELY(mem == nullptr)) {
+        return Object<T, RefCount>();
+    }
+    return Object<T, RefCount>(new (mem) Block(allocator, std::forward<Args>(args)...));
 }
 
-template <class T>
+/**
+ * @brief Reference counting owner of T. It holds one pointer to the control block, which points to the object.
+ * RefCount tells how the count is updated:
+ * - NonAtomicRefCount for objects used by one thread
+ * - AtomicRefCount for objects shared by threads
+ * - BiasedRefCount for shared objects mostly used by the thread which created them
+ * Like std::shared_ptr, one Object should not be changed by several threads at once, its copies may be
+ */
+template <class T, class RefCount>
 class Object {
 public:
     Object() = default;
     explicit Object(std::nullptr_t) {}
-    explicit Object([[maybe_unused]] T *ptr) {}
+    explicit Object(T *ptr) : block_(ptr == nullptr ? nullptr : new PointerObjectBlock<T, RefCount>(ptr)) {}
 
-    ~Object() = default; // this method should be changed
+    ~Object()
+    {
+        if (block_ != nullptr) {
+            block_->Release();
+        }
+    }
 
     // copy semantic
-    Object([[maybe_unused]] const Object<T> &other) {}
+    Object(const Object &other) : block_(other.block_)
+    {
+        if (block_ != nullptr) {
+            block_->Acquire();
+        }
+    }
     // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
-    Object<T> &operator=([[maybe_unused]] const Object<T> &other)
+    Object &operator=(const Object &other)
     {
+        // the new reference is taken first, so self assignment does not destroy the object
+        Object(other).Swap(*this);
         return *this;
     }
 
     // move semantic
-    Object([[maybe_unused]] Object<T> &&other) {}
-    Object<T> &operator=([[maybe_unused]] Object<T> &&other)
+    Object(Object &&other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+    Object &operator=(Object &&other) noexcept
     {
+        Object(std::move(other)).Swap(*this);
         return *this;
     }
 
     // member access operators
-    T &operator*() const noexcept {
-        return *val_;
+    T &operator*() const noexcept
+    {
+        return *Get();
     }
 
-    T *operator->() const noexcept {
-        return val_;
+    T *operator->() const noexcept
+    {
+        return Get();
     }
 
     // internal access
-    void Reset([[maybe_unused]] T *ptr) {}
+    void Reset(T *ptr)
+    {
+        Object(ptr).Swap(*this);
+    }
     T *Get() const
     {
-        return val_;
+        return block_ == nullptr ? nullptr : static_cast<T *>(block_->GetObject());
     }
     size_t UseCount() const
     {
-        return 0;
+        return block_ == nullptr ? 0U : block_->UseCount();
+    }
+
+    void Swap(Object &other) noexcept
+    {
+        std::swap(block_, other.block_);
     }
 
 private:
-    // TODO(you): Add your fields and methods here...
-    T* val_ = nullptr; // this field can be deleted
+    // takes the reference of the new @param block
+    explicit Object(ObjectBlock<RefCount> *block) : block_(block) {}
+
+    ObjectBlock<RefCount> *block_ = nullptr;
+
+    template <class U, class Count, class... Args>
+    friend Object<U, Count> MakeObject(Args &&...args);
+    template <class U, class Count, class Allocator, class... Args>
+    friend Object<U, Count> AllocateObject(Allocator &allocator, Args &&...args);
+    friend class ObjectBlock<RefCount>;
+    friend class ObjectRef<T, RefCount>;
+    friend class WeakObject<T, RefCount>;
 };
 
-#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODEL_H
\ No newline at end of file
+#endif  // MEMORY_MANAGEMENT_REFERECNCE_COUNTING_GC_INCLUDE_OBJECT_MODEL_H
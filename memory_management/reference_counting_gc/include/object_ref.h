@@ -0,0 +1,140 @@
+#ifndef MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_OBJECT_REF_H
+#define MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_OBJECT_REF_H
+
+#include <cstddef>
+#include <utility>
+#include "base/macros.h"
+#include "memory_management/reference_counting_gc/include/object_module.h"
+
+/**
+ * @brief Borrowed reference to an object owned by Object, like std::string_view for strings: it does not change the
+ * count, so passing it to functions and iterating over objects costs nothing. The object should be kept alive by an
+ * Object for the time the reference is used, ToObject() makes a new owner when the reference should be stored
+ */
+template <class T, class RefCount = NonAtomicRefCount>
+class ObjectRef {
+public:
+    ObjectRef() = default;
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    ObjectRef(std::nullptr_t) {}
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    ObjectRef(const Object<T, RefCount> &object) : block_(object.block_) {}
+    ~ObjectRef() = default;
+    DEFAULT_COPY_SEMANTIC(ObjectRef);
+    DEFAULT_MOVE_SEMANTIC(ObjectRef);
+
+    // member access operators
+    T &operator*() const noexcept
+    {
+        return *Get();
+    }
+
+    T *operator->() const noexcept
+    {
+        return Get();
+    }
+
+    T *Get() const
+    {
+        return block_ == nullptr ? nullptr : static_cast<T *>(block_->GetObject());
+    }
+    size_t UseCount() const
+    {
+        return block_ == nullptr ? 0U : block_->UseCount();
+    }
+
+    // @returns new owner of the object
+    Object<T, RefCount> ToObject() const
+    {
+        if (block_ == nullptr) {
+            return Object<T, RefCount>();
+        }
+        block_->Acquire();
+        return Object<T, RefCount>(block_);
+    }
+
+private:
+    ObjectBlock<RefCount> *block_ = nullptr;
+};
+
+/**
+ * @brief Weak reference to an object owned by Object, e.g. for caches: it keeps the control block, but not the
+ * object, which is destroyed with the last Object. Lock() gives an owner of the object if it is still alive.
+ * RefCount should support weak references, see HAS_WEAK_COUNT
+ */
+template <class T, class RefCount = NonAtomicRefCount>
+class WeakObject {
+    static_assert(HAS_WEAK_COUNT<RefCount>, "RefCount does not support weak references");
+
+public:
+    WeakObject() = default;
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    WeakObject(const Object<T, RefCount> &object) : block_(object.block_)
+    {
+        if (block_ != nullptr) {
+            block_->AcquireWeak();
+        }
+    }
+
+    ~WeakObject()
+    {
+        if (block_ != nullptr) {
+            block_->ReleaseWeak();
+        }
+    }
+
+    // copy semantic
+    WeakObject(const WeakObject &other) : block_(other.block_)
+    {
+        if (block_ != nullptr) {
+            block_->AcquireWeak();
+        }
+    }
+    // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
+    WeakObject &operator=(const WeakObject &other)
+    {
+        WeakObject(other).Swap(*this);
+        return *this;
+    }
+
+    // move semantic
+    WeakObject(WeakObject &&other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+    WeakObject &operator=(WeakObject &&other) noexcept
+    {
+        WeakObject(std::move(other)).Swap(*this);
+        return *this;
+    }
+
+    // @returns owner of the object or empty Object if the object is destroyed
+    Object<T, RefCount> Lock() const
+    {
+        if (block_ == nullptr || !block_->TryAcquire()) {
+            return Object<T, RefCount>();
+        }
+        return Object<T, RefCount>(block_);
+    }
+
+    bool Expired() const
+    {
+        return UseCount() == 0U;
+    }
+    size_t UseCount() const
+    {
+        return block_ == nullptr ? 0U : block_->UseCount();
+    }
+
+    void Reset()
+    {
+        WeakObject().Swap(*this);
+    }
+
+    void Swap(WeakObject &other) noexcept
+    {
+        std::swap(block_, other.block_);
+    }
+
+private:
+    ObjectBlock<RefCount> *block_ = nullptr;
+};
+
+#endif  // MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_OBJECT_REF_H
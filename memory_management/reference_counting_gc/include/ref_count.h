@@ -0,0 +1,304 @@
+#ifndef MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_REF_COUNT_H
+#define MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_REF_COUNT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "base/macros.h"
+
+/**
+ * Reference counting policies of Object. A policy is the base of the object control block and provides
+ *   void Acquire() - adds a reference
+ *   bool Release() - drops a reference, @returns true if the object should be destroyed
+ *   size_t UseCount() const
+ * Every count starts with the one reference of the created object.
+ * Policies supporting WeakObject also provide
+ *   bool TryAcquire() - adds a reference if the object is alive, @returns false otherwise
+ *   void AcquireWeak() - adds a weak reference
+ *   bool ReleaseWeak() - drops a weak reference, @returns true if the block should be freed
+ * The alive object holds one weak reference, so the block is freed after both the object and weak references.
+ * Counts of such policies are 32 bit, like the counts of std::shared_ptr, so both fit one word
+ */
+
+// Plain count for objects used by one thread only
+class NonAtomicRefCount {
+public:
+    void Acquire()
+    {
+        ++count_;
+    }
+
+    bool Release()
+    {
+        return --count_ == 0U;
+    }
+
+    size_t UseCount() const
+    {
+        return count_;
+    }
+
+    bool TryAcquire()
+    {
+        if (count_ == 0U) {
+            return false;
+        }
+        ++count_;
+        return true;
+    }
+
+    void AcquireWeak()
+    {
+        ++weakCount_;
+    }
+
+    bool ReleaseWeak()
+    {
+        return --weakCount_ == 0U;
+    }
+
+private:
+    uint32_t count_ = 1U;
+    uint32_t weakCount_ = 1U;
+};
+
+// Count for objects shared by threads, every update is an atomic read-modify-write
+class AtomicRefCount {
+public:
+    void Acquire()
+    {
+        // a new reference is made from an existing one, so there is nothing to synchronize with
+        count_.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    bool Release()
+    {
+        // the last owner should see all writes to the object made through other references
+        return count_.fetch_sub(1U, std::memory_order_acq_rel) == 1U;
+    }
+
+    size_t UseCount() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    bool TryAcquire()
+    {
+        uint32_t count = count_.load(std::memory_order_relaxed);
+        do {
+            if (count == 0U) {
+                return false;
+            }
+        } while (!count_.compare_exchange_weak(count, count + 1U, std::memory_order_relaxed));
+        return true;
+    }
+
+    void AcquireWeak()
+    {
+        weakCount_.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    bool ReleaseWeak()
+    {
+        // without weak references nobody can make a new one, so the atomic update is not needed
+        if (weakCount_.load(std::memory_order_acquire) == 1U) {
+            return true;
+        }
+        return weakCount_.fetch_sub(1U, std::memory_order_acq_rel) == 1U;
+    }
+
+private:
+    std::atomic<uint32_t> count_ {1U};
+    std::atomic<uint32_t> weakCount_ {1U};
+};
+
+// WeakObject may refer to objects with RefCount
+template <class RefCount, class = void>
+constexpr bool HAS_WEAK_COUNT = false;
+template <class RefCount>
+constexpr bool HAS_WEAK_COUNT<RefCount, std::void_t<decltype(std::declval<RefCount &>().ReleaseWeak())>> = true;
+
+/**
+ * @brief Biased reference counting: the thread which created the object (its owner) updates the biased count
+ * without atomic read-modify-writes, other threads update the atomic shared count. When the owner drops its last
+ * reference, the biased count is merged into the shared one and the object becomes an ordinary atomic counted one.
+ * If another thread drives the shared count below zero (it releases a reference made by the owner), the object is
+ * queued to the owner, which merges it on its next release or in MergeQueued(). Objects queued to a finished thread
+ * are merged by the releasing thread itself.
+ */
+class BiasedRefCount {
+    // the shared count is kept in the high bits of shared_
+    static constexpr int64_t MERGED = 1;
+    static constexpr int64_t QUEUED = 2;
+    static constexpr int64_t COUNT_UNIT = 4;
+
+    // objects queued by other threads to their owner
+    struct OwnerThread {
+        std::atomic<BiasedRefCount *> queue {nullptr};
+        OwnerThread *next = nullptr;
+    };
+
+public:
+    BiasedRefCount() = default;
+    ~BiasedRefCount() = default;
+    NO_COPY_SEMANTIC(BiasedRefCount);
+    NO_MOVE_SEMANTIC(BiasedRefCount);
+
+    void Acquire()
+    {
+        if (IsOwned()) {
+            biased_.store(biased_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+        } else {
+            shared_.fetch_add(COUNT_UNIT, std::memory_order_relaxed);
+        }
+    }
+
+    bool Release()
+    {
+        if (IsOwned()) {
+            if (UNLIKELY(owner_->queue.load(std::memory_order_relaxed) != nullptr)) {
+                MergeQueued();
+                // this object may have been queued too
+                if (merged_) {
+                    return ReleaseShared();
+                }
+            }
+            size_t biased = biased_.load(std::memory_order_relaxed) - 1U;
+            biased_.store(biased, std::memory_order_relaxed);
+            return biased == 0U && Merge() == MERGED;
+        }
+        return ReleaseShared();
+    }
+
+    size_t UseCount() const
+    {
+        // it is approximate while other threads update the counts
+        int64_t shared = shared_.load(std::memory_order_relaxed);
+        shared = (shared - (shared & (COUNT_UNIT - 1))) / COUNT_UNIT;
+        return static_cast<size_t>(shared + static_cast<int64_t>(biased_.load(std::memory_order_relaxed)));
+    }
+
+    /**
+     * @brief Merges objects queued to the calling thread by other threads and destroys unreferenced ones.
+     * It is called on releases of the owner, a thread which rarely releases its objects may call it by itself
+     */
+    static void MergeQueued()
+    {
+        OwnerThread *thread = CurrentThread();
+        // only the thread itself closes its queue
+        BiasedRefCount *head = thread->queue.load(std::memory_order_relaxed);
+        if (head != nullptr && head != Closed()) {
+            MergeList(thread->queue.exchange(nullptr, std::memory_order_acquire));
+        }
+    }
+
+private:
+    // the record of a thread is never freed: objects of a finished thread still point to it
+    static OwnerThread *CurrentThread()
+    {
+        thread_local OwnerThread *thread = [] {
+            auto *owner = new OwnerThread();
+            // records stay reachable from the list of all threads
+            static std::atomic<OwnerThread *> threads {nullptr};
+            owner->next = threads.load(std::memory_order_relaxed);
+            while (!threads.compare_exchange_weak(owner->next, owner, std::memory_order_relaxed)) {
+            }
+            thread_local ThreadExit exit(owner);
+            return owner;
+        }();
+        return thread;
+    }
+
+    // merges what is queued on the thread exit and makes the releasing threads merge the objects themselves
+    class ThreadExit {
+    public:
+        explicit ThreadExit(OwnerThread *thread) : thread_(thread) {}
+        ~ThreadExit()
+        {
+            // releasing threads should see the last biased counts of this thread
+            MergeList(thread_->queue.exchange(Closed(), std::memory_order_acq_rel));
+        }
+        NO_COPY_SEMANTIC(ThreadExit);
+        NO_MOVE_SEMANTIC(ThreadExit);
+
+    private:
+        OwnerThread *thread_;
+    };
+
+    // marks the queue of a finished thread
+    static BiasedRefCount *Closed()
+    {
+        static BiasedRefCount closed;
+        return &closed;
+    }
+
+    bool IsOwned() const
+    {
+        // merged_ may be set by another thread only after the owner has finished
+        return owner_ == CurrentThread() && !merged_;
+    }
+
+    bool ReleaseShared()
+    {
+        int64_t shared = shared_.fetch_sub(COUNT_UNIT, std::memory_order_acq_rel) - COUNT_UNIT;
+        if ((shared & MERGED) != 0) {
+            // a queued object is destroyed by its owner
+            return shared == MERGED;
+        }
+        // the count of the owner is merged by the owner, so the object is queued to it once
+        if (shared < 0 && (shared & QUEUED) == 0 &&
+            (shared_.fetch_or(QUEUED, std::memory_order_relaxed) & QUEUED) == 0) {
+            return Enqueue();
+        }
+        return false;
+    }
+
+    // moves the biased count to the shared one, @returns the new value of shared_
+    int64_t Merge()
+    {
+        auto biased = static_cast<int64_t>(biased_.load(std::memory_order_relaxed));
+        merged_ = true;
+        biased_.store(0U, std::memory_order_relaxed);
+        return shared_.fetch_add(biased * COUNT_UNIT + MERGED, std::memory_order_acq_rel) + biased * COUNT_UNIT +
+               MERGED;
+    }
+
+    // @returns true if the object has been merged by this thread instead of its finished owner and should be destroyed
+    bool Enqueue()
+    {
+        // the closed queue is read with acquire to see the last biased count of the owner
+        BiasedRefCount *head = owner_->queue.load(std::memory_order_acquire);
+        do {
+            if (head == Closed()) {
+                return MergeDequeued();
+            }
+            nextQueued_ = head;
+        } while (
+            !owner_->queue.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_acquire));
+        return false;
+    }
+
+    // @returns true if the dequeued object is not referenced anymore
+    bool MergeDequeued()
+    {
+        if (!merged_) {
+            Merge();
+        }
+        return (shared_.fetch_and(~QUEUED, std::memory_order_acq_rel) & ~QUEUED) == MERGED;
+    }
+
+    // defined with the control block, which is destroyed for unreferenced objects
+    static void MergeList(BiasedRefCount *list);
+
+    OwnerThread *owner_ = CurrentThread();
+    // count of references of the owner, it is updated by the owner only
+    std::atomic<size_t> biased_ {1U};
+    std::atomic<int64_t> shared_ {0};
+    // set by the owner or, after the owner has finished, by the thread which queued the object
+    bool merged_ = false;
+    BiasedRefCount *nextQueued_ = nullptr;
+};
+
+#endif  // MEMORY_MANAGEMENT_REFERENCE_COUNTING_GC_INCLUDE_REF_COUNT_H
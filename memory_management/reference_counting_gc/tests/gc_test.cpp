@@ -1,8 +1,135 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+#include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+#include "memory_management/reference_counting_gc/include/cycle_collector.h"
+#include "memory_management/reference_counting_gc/include/deferred_release.h"
 #include "memory_management/reference_counting_gc/include/object_module.h"
+#include "memory_management/reference_counting_gc/include/object_ref.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
 #include "base/macros.h"
 #include "delete_detector.h"
 
+namespace {
+// tests of shared objects allocate from several threads
+std::atomic<size_t> g_allocationsCount = 0U;
+
+// counts destructor calls of objects shared by threads
+class DestroyCounter {
+public:
+    explicit DestroyCounter(std::atomic<size_t> &count) : count_(count) {}
+    ~DestroyCounter()
+    {
+        ++count_;
+    }
+    NO_COPY_SEMANTIC(DestroyCounter);
+    NO_MOVE_SEMANTIC(DestroyCounter);
+
+private:
+    std::atomic<size_t> &count_;
+};
+
+// node of object graphs with cycles
+class CycleNode {
+public:
+    explicit CycleNode(size_t &count) : count_(count) {}
+    ~CycleNode()
+    {
+        ++count_;
+    }
+    NO_COPY_SEMANTIC(CycleNode);
+    NO_MOVE_SEMANTIC(CycleNode);
+
+    template <class Visitor>
+    void VisitReferences(Visitor &&visitor)
+    {
+        visitor(next);
+        visitor(other);
+    }
+
+    Object<CycleNode, CycleCollectedRefCount> next;  // NOLINT(misc-non-private-member-variables-in-classes)
+    Object<CycleNode, CycleCollectedRefCount> other;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    size_t &count_;
+};
+
+// element of long chains released by ReleaseQueue
+class ChainNode {
+public:
+    explicit ChainNode(size_t &count) : count_(count) {}
+    ~ChainNode()
+    {
+        ++count_;
+    }
+    NO_COPY_SEMANTIC(ChainNode);
+    NO_MOVE_SEMANTIC(ChainNode);
+
+    Object<ChainNode, DeferredRefCount> next;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    size_t &count_;
+};
+
+// @returns head of a chain of @param length nodes
+Object<ChainNode, DeferredRefCount> MakeChain(size_t length, size_t &destroyed)
+{
+    auto head = MakeObject<ChainNode, DeferredRefCount>(destroyed);
+    ChainNode *tail = head.Get();
+    for (size_t i = 1U; i < length; ++i) {
+        tail->next = MakeObject<ChainNode, DeferredRefCount>(destroyed);
+        tail = tail->next.Get();
+    }
+    return head;
+}
+
+// copies @param obj in @param threads_count threads and drops the copies
+template <class RefCount>
+void CopyInThreads(const Object<DestroyCounter, RefCount> &obj, size_t threads_count)
+{
+    constexpr size_t COPIES_COUNT = 10000U;
+    std::vector<std::thread> threads;
+    for (size_t i = 0U; i < threads_count; ++i) {
+        threads.emplace_back([&obj] {
+            std::vector<Object<DestroyCounter, RefCount>> copies;
+            for (size_t j = 0U; j < COPIES_COUNT; ++j) {
+                copies.push_back(obj);
+                if (j % 2U == 1U) {
+                    copies.pop_back();
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+}  // namespace
+
+// counts allocations of the test, so the count of allocations done by MakeObject() can be checked
+void *operator new(size_t size)
+{
+    ++g_allocationsCount;
+    void *mem = std::malloc(size == 0U ? 1U : size);  // NOLINT(cppcoreguidelines-no-malloc)
+    if (mem == nullptr) {
+        throw std::bad_alloc();
+    }
+    return mem;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void operator delete(void *ptr, [[maybe_unused]] size_t size) noexcept
+{
+    std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
 class Return42 {
     static constexpr size_t RET_42 = 42U;
 public:
@@ -12,7 +139,7 @@ public:
     }
 };
 
-TEST(ReferenceCountingGC, DISABLED_SinglePtrUsage)
+TEST(ReferenceCountingGC, SinglePtrUsage)
 {
     Object<size_t> obj;
     ASSERT_EQ(obj.UseCount(), 0);
@@ -30,7 +157,7 @@ TEST(ReferenceCountingGC, DISABLED_SinglePtrUsage)
     ASSERT_EQ(classObj->Get(), Return42().Get());
 }
 
-TEST(ReferenceCountingGC, DISABLED_CopySemanticUsage)
+TEST(ReferenceCountingGC, CopySemanticUsage)
 {
     constexpr size_t VALUE_TO_CREATE = 42U;
     Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
@@ -49,7 +176,7 @@ TEST(ReferenceCountingGC, DISABLED_CopySemanticUsage)
     ASSERT_EQ(obj1.UseCount(), 1U);
 }
 
-TEST(ReferenceCountingGC, DISABLED_MoveSemanticUsage)
+TEST(ReferenceCountingGC, MoveSemanticUsage)
 {
     constexpr size_t VALUE_TO_CREATE = 42U;
     Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
@@ -71,7 +198,7 @@ TEST(ReferenceCountingGC, DISABLED_MoveSemanticUsage)
     ASSERT_EQ(obj1.UseCount(), 1U);
 }
 
-TEST(ReferenceCountingGC, DISABLED_GcDeletingTest) {
+TEST(ReferenceCountingGC, GcDeletingTest) {
     DeleteDetector::SetDeleteCount(0U);
     auto obj1 = MakeObject<DeleteDetector>();
     {
@@ -87,7 +214,7 @@ TEST(ReferenceCountingGC, DISABLED_GcDeletingTest) {
     ASSERT_EQ(DeleteDetector::GetDeleteCount(), 3U);
 }
 
-TEST(ReferenceCountingGC, DISABLED_CorrectPtrReset) {
+TEST(ReferenceCountingGC, CorrectPtrReset) {
     constexpr size_t VALUE_TO_CREATE = 42U;
     Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
     Object<size_t> obj2 = obj1;
@@ -96,4 +223,347 @@ TEST(ReferenceCountingGC, DISABLED_CorrectPtrReset) {
     constexpr size_t VALUE_TO_RESET = 206U;
     obj2.Reset(new size_t(VALUE_TO_RESET));
     ASSERT_NE(obj1.Get(), obj2.Get());
-}
\ No newline at end of file
+}
+TEST(ReferenceCountingGC, SingleAllocationTest)
+{
+    constexpr size_t VALUE_TO_CREATE = 42U;
+    size_t allocationsCount = g_allocationsCount;
+    Object<size_t> obj1 = MakeObject<size_t>(VALUE_TO_CREATE);
+    ASSERT_EQ(g_allocationsCount, allocationsCount + 1U);
+    {
+        Object<size_t> obj2 = obj1;
+        ASSERT_EQ(g_allocationsCount, allocationsCount + 1U);
+    }
+
+    // an object passed by pointer needs a separate control block
+    allocationsCount = g_allocationsCount;
+    obj1.Reset(new size_t(VALUE_TO_CREATE));
+    ASSERT_EQ(g_allocationsCount, allocationsCount + 2U);
+    ASSERT_EQ(*obj1, VALUE_TO_CREATE);
+    obj1.Reset(nullptr);
+    ASSERT_EQ(obj1.UseCount(), 0U);
+    ASSERT_EQ(obj1.Get(), nullptr);
+}
+
+TEST(ReferenceCountingGC, SlotAllocatorTest)
+{
+    constexpr size_t OBJECTS_COUNT = 100U;
+    // every block with DeleteDetector takes a slot of 64 bytes
+    constexpr size_t MEMORY_POOL_SIZE = OBJECTS_COUNT * 64U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 32U, 64U> allocator;
+    DeleteDetector::SetDeleteCount(0U);
+    size_t allocationsCount = 0U;
+    {
+        std::vector<Object<DeleteDetector>> objects;
+        objects.reserve(OBJECTS_COUNT);
+        // the first object creates the pool
+        objects.push_back(AllocateObject<DeleteDetector>(allocator));
+        allocationsCount = g_allocationsCount;
+        for (size_t i = 1U; i < OBJECTS_COUNT; ++i) {
+            objects.push_back(AllocateObject<DeleteDetector>(allocator));
+            ASSERT_TRUE(allocator.OwnsPoolOf(objects.back().Get()));
+            ASSERT_EQ(objects.back().UseCount(), 1U);
+        }
+        // the chain is linked through slots too
+        objects.front()->SetDelete(objects.back());
+        ASSERT_EQ(objects.back().UseCount(), 2U);
+    }
+    ASSERT_EQ(g_allocationsCount, allocationsCount);
+    ASSERT_EQ(DeleteDetector::GetDeleteCount(), OBJECTS_COUNT);
+    ASSERT_EQ(allocator.Trim(), 1U);
+}
+
+TEST(ReferenceCountingGC, ArenaAllocatorTest)
+{
+    constexpr size_t ARENA_SIZE = 256U;
+    constexpr size_t VALUE_TO_CREATE = 42U;
+    BumpPointerAllocator<ARENA_SIZE> arena;
+
+    Object<size_t> obj1 = AllocateObject<size_t>(arena, VALUE_TO_CREATE);
+    ASSERT_EQ(*obj1, VALUE_TO_CREATE);
+    Object<size_t> obj2 = obj1;
+    ASSERT_EQ(obj1.UseCount(), 2U);
+    // the arena is out of memory
+    std::vector<Object<size_t>> objects;
+    for (Object<size_t> obj = AllocateObject<size_t>(arena); obj.Get() != nullptr;
+         obj = AllocateObject<size_t>(arena)) {
+        objects.push_back(obj);
+    }
+    ASSERT_FALSE(objects.empty());
+    ASSERT_EQ(AllocateObject<size_t>(arena).UseCount(), 0U);
+    // memory of destroyed objects is given back with the arena
+    objects.clear();
+    obj1.Reset(nullptr);
+    obj2.Reset(nullptr);
+    arena.Free();
+    ASSERT_NE(AllocateObject<size_t>(arena, VALUE_TO_CREATE).Get(), nullptr);
+}
+
+TEST(ReferenceCountingGC, AtomicRefCountTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    std::atomic<size_t> destroyed = 0U;
+    {
+        Object<DestroyCounter, AtomicRefCount> obj = MakeObject<DestroyCounter, AtomicRefCount>(destroyed);
+        CopyInThreads(obj, THREADS_COUNT);
+        ASSERT_EQ(obj.UseCount(), 1U);
+        ASSERT_EQ(destroyed, 0U);
+    }
+    ASSERT_EQ(destroyed, 1U);
+}
+
+TEST(ReferenceCountingGC, BiasedRefCountTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    std::atomic<size_t> destroyed = 0U;
+    {
+        // the owner keeps the counts without atomic read-modify-writes
+        auto obj = MakeObject<DestroyCounter, BiasedRefCount>(destroyed);
+        auto copy = obj;
+        ASSERT_EQ(obj.UseCount(), 2U);
+        copy.Reset(nullptr);
+        CopyInThreads(obj, THREADS_COUNT);
+        ASSERT_EQ(obj.UseCount(), 1U);
+        ASSERT_EQ(destroyed, 0U);
+    }
+    ASSERT_EQ(destroyed, 1U);
+
+    // other thread releases the references of the owner, which merges the counts and destroys the object
+    {
+        auto obj = MakeObject<DestroyCounter, BiasedRefCount>(destroyed);
+        auto copy = obj;
+        std::thread([moved = std::move(copy)]() mutable { moved.Reset(nullptr); }).join();
+        ASSERT_EQ(destroyed, 1U);
+        ASSERT_EQ(obj.UseCount(), 1U);
+    }
+    ASSERT_EQ(destroyed, 2U);
+    {
+        auto obj = MakeObject<DestroyCounter, BiasedRefCount>(destroyed);
+        std::thread([moved = std::move(obj)]() mutable { moved.Reset(nullptr); }).join();
+        ASSERT_EQ(destroyed, 2U);
+        BiasedRefCount::MergeQueued();
+    }
+    ASSERT_EQ(destroyed, 3U);
+
+    // objects of a finished thread are merged by the thread which releases them
+    Object<DestroyCounter, BiasedRefCount> obj;
+    std::thread([&obj, &destroyed] { obj = MakeObject<DestroyCounter, BiasedRefCount>(destroyed); }).join();
+    ASSERT_EQ(obj.UseCount(), 1U);
+    auto copy = obj;
+    obj.Reset(nullptr);
+    ASSERT_EQ(destroyed, 3U);
+    copy.Reset(nullptr);
+    ASSERT_EQ(destroyed, 4U);
+}
+
+TEST(ReferenceCountingGC, CycleCollectorTest)
+{
+    CycleCollector &collector = CycleCollector::Current();
+    collector.SetCollectThreshold(0U);
+    size_t destroyed = 0U;
+    {
+        auto node = MakeObject<CycleNode, CycleCollectedRefCount>(destroyed);
+        node->next = node;
+    }
+    ASSERT_EQ(collector.GetRootsCount(), 1U);
+    ASSERT_EQ(destroyed, 0U);
+    ASSERT_EQ(collector.Collect(), 1U);
+    ASSERT_EQ(destroyed, 1U);
+    ASSERT_EQ(collector.GetRootsCount(), 0U);
+
+    // a cycle referenced from outside is alive
+    auto alive = MakeObject<CycleNode, CycleCollectedRefCount>(destroyed);
+    {
+        auto node = MakeObject<CycleNode, CycleCollectedRefCount>(destroyed);
+        node->next = alive;
+        alive->next = node;
+    }
+    ASSERT_EQ(collector.Collect(), 0U);
+    ASSERT_EQ(alive.UseCount(), 2U);
+    ASSERT_EQ(alive->next.UseCount(), 1U);
+    // garbage releases objects it refers to
+    auto leaf = MakeObject<CycleNode, CycleCollectedRefCount>(destroyed);
+    alive->other = leaf;
+    ASSERT_EQ(leaf.UseCount(), 2U);
+    alive.Reset(nullptr);
+    ASSERT_EQ(collector.Collect(), 2U);
+    ASSERT_EQ(destroyed, 3U);
+    ASSERT_EQ(leaf.UseCount(), 1U);
+    collector.SetCollectThreshold(CycleCollector::DEFAULT_COLLECT_THRESHOLD);
+}
+
+TEST(ReferenceCountingGC, LongCycleTest)
+{
+    constexpr size_t NODES_COUNT = 100000U;
+    CycleCollector &collector = CycleCollector::Current();
+    collector.SetCollectThreshold(0U);
+    size_t destroyed = 0U;
+    {
+        auto head = MakeObject<CycleNode, CycleCollectedRefCount>(destroyed);
+        auto tail = head;
+        for (size_t i = 1U; i < NODES_COUNT; ++i) {
+            tail->next = MakeObject<CycleNode, CycleCollectedRefCount>(destroyed);
+            tail = tail->next;
+        }
+        tail->next = head;
+    }
+    // the traversal does not recur, the garbage is destroyed one by one
+    ASSERT_EQ(collector.Collect(), NODES_COUNT);
+    ASSERT_EQ(destroyed, NODES_COUNT);
+    collector.SetCollectThreshold(CycleCollector::DEFAULT_COLLECT_THRESHOLD);
+}
+
+TEST(ReferenceCountingGC, CycleCollectorBatchTest)
+{
+    constexpr size_t CYCLES_COUNT = 4U;
+    CycleCollector &collector = CycleCollector::Current();
+    collector.SetCollectThreshold(0U);
+    size_t destroyed = 0U;
+    auto makeCycle = [&destroyed] {
+        auto node = MakeObject<CycleNode, CycleCollectedRefCount>(destroyed);
+        node->next = node;
+    };
+    for (size_t i = 0U; i < CYCLES_COUNT - 1U; ++i) {
+        makeCycle();
+    }
+    // batches are bounded by count of roots
+    ASSERT_EQ(collector.Collect(1U), 1U);
+    ASSERT_EQ(collector.GetRootsCount(), CYCLES_COUNT - 2U);
+    ASSERT_EQ(collector.Collect(CYCLES_COUNT), CYCLES_COUNT - 2U);
+
+    // the full buffer is collected automatically
+    collector.SetCollectThreshold(CYCLES_COUNT);
+    for (size_t i = 0U; i < CYCLES_COUNT - 1U; ++i) {
+        makeCycle();
+    }
+    ASSERT_EQ(destroyed, CYCLES_COUNT - 1U);
+    makeCycle();
+    ASSERT_EQ(destroyed, 2U * CYCLES_COUNT - 1U);
+    ASSERT_EQ(collector.GetRootsCount(), 0U);
+    collector.SetCollectThreshold(CycleCollector::DEFAULT_COLLECT_THRESHOLD);
+}
+
+TEST(ReferenceCountingGC, DeferredReleaseTest)
+{
+    constexpr size_t CHAIN_LENGTH = 1000000U;
+    constexpr size_t BUDGET = 100U;
+    ReleaseQueue &queue = ReleaseQueue::Current();
+    queue.SetAllocationBudget(0U);
+    size_t destroyed = 0U;
+    auto head = MakeChain(CHAIN_LENGTH, destroyed);
+    head.Reset(nullptr);
+    // the chain is destroyed in slices
+    ASSERT_EQ(destroyed, 0U);
+    ASSERT_EQ(queue.GetPendingCount(), 1U);
+    ASSERT_EQ(DrainReleases(BUDGET), BUDGET);
+    ASSERT_EQ(destroyed, BUDGET);
+    ASSERT_EQ(queue.GetPendingCount(), 1U);
+    // the rest does not overflow the stack
+    ASSERT_EQ(DrainReleases(), CHAIN_LENGTH - BUDGET);
+    ASSERT_EQ(destroyed, CHAIN_LENGTH);
+    ASSERT_EQ(queue.GetPendingCount(), 0U);
+    ASSERT_EQ(DrainReleases(), 0U);
+    queue.SetAllocationBudget(ReleaseQueue::DEFAULT_ALLOCATION_BUDGET);
+}
+
+TEST(ReferenceCountingGC, DrainOnAllocationTest)
+{
+    constexpr size_t CHAIN_LENGTH = 10U;
+    constexpr size_t BUDGET = 3U;
+    ReleaseQueue &queue = ReleaseQueue::Current();
+    queue.SetAllocationBudget(BUDGET);
+    size_t destroyed = 0U;
+    // the chain itself drains nothing, it is created with the queue empty
+    MakeChain(CHAIN_LENGTH, destroyed).Reset(nullptr);
+    ASSERT_EQ(destroyed, 0U);
+    auto obj = MakeObject<ChainNode, DeferredRefCount>(destroyed);
+    ASSERT_EQ(destroyed, BUDGET);
+    // the replaced object is queued too
+    obj = MakeObject<ChainNode, DeferredRefCount>(destroyed);
+    ASSERT_EQ(destroyed, 2U * BUDGET);
+    ASSERT_EQ(queue.GetPendingCount(), 2U);
+    DrainReleases();
+    ASSERT_EQ(destroyed, CHAIN_LENGTH + 1U);
+    queue.SetAllocationBudget(ReleaseQueue::DEFAULT_ALLOCATION_BUDGET);
+}
+
+TEST(ReferenceCountingGC, ObjectRefTest)
+{
+    constexpr size_t VALUE_TO_CREATE = 42U;
+    auto useCount = [](ObjectRef<size_t> ref) { return ref.UseCount(); };
+    Object<size_t> obj = MakeObject<size_t>(VALUE_TO_CREATE);
+    // borrowing does not change the count
+    ASSERT_EQ(useCount(obj), 1U);
+    ASSERT_EQ(useCount(MakeObject<size_t>(VALUE_TO_CREATE)), 1U);
+    ASSERT_EQ(useCount(nullptr), 0U);
+
+    ObjectRef<size_t> ref = obj;
+    ASSERT_EQ(ref.Get(), obj.Get());
+    ASSERT_EQ(*ref, VALUE_TO_CREATE);
+    Object<size_t> owner = ref.ToObject();
+    ASSERT_EQ(owner.Get(), obj.Get());
+    ASSERT_EQ(obj.UseCount(), 2U);
+    ASSERT_EQ(ObjectRef<size_t>().ToObject().Get(), nullptr);
+}
+
+TEST(ReferenceCountingGC, WeakObjectTest)
+{
+    DeleteDetector::SetDeleteCount(0U);
+    auto obj = MakeObject<DeleteDetector>();
+    WeakObject<DeleteDetector> weak = obj;
+    ASSERT_FALSE(weak.Expired());
+    ASSERT_EQ(weak.UseCount(), 1U);
+    {
+        Object<DeleteDetector> locked = weak.Lock();
+        ASSERT_EQ(locked.Get(), obj.Get());
+        ASSERT_EQ(obj.UseCount(), 2U);
+    }
+    // the object is destroyed with the last owner, the block is kept by the weak reference
+    WeakObject<DeleteDetector> copy = weak;
+    obj.Reset(nullptr);
+    ASSERT_EQ(DeleteDetector::GetDeleteCount(), 1U);
+    ASSERT_TRUE(weak.Expired());
+    ASSERT_EQ(weak.Lock().Get(), nullptr);
+    ASSERT_TRUE(copy.Expired());
+    weak.Reset();
+    ASSERT_EQ(weak.UseCount(), 0U);
+
+    // blocks of an allocator and of a passed pointer
+    RunOfSlotsAllocator<4096U, 64U> allocator;
+    auto allocated = AllocateObject<DeleteDetector>(allocator);
+    WeakObject<DeleteDetector> allocatedWeak = allocated;
+    allocated.Reset(nullptr);
+    ASSERT_EQ(DeleteDetector::GetDeleteCount(), 2U);
+    ASSERT_TRUE(allocatedWeak.Expired());
+    allocatedWeak.Reset();
+    Object<size_t> pointed(new size_t(0U));
+    WeakObject<size_t> pointedWeak = pointed;
+    pointed.Reset(nullptr);
+    ASSERT_TRUE(pointedWeak.Expired());
+}
+
+TEST(ReferenceCountingGC, AtomicWeakObjectTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    std::atomic<size_t> destroyed = 0U;
+    auto obj = MakeObject<DestroyCounter, AtomicRefCount>(destroyed);
+    WeakObject<DestroyCounter, AtomicRefCount> weak = obj;
+    // threads lock the object while it is released
+    std::vector<std::thread> threads;
+    for (size_t i = 0U; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([weak] {
+            while (true) {
+                auto locked = weak.Lock();
+                if (locked.Get() == nullptr) {
+                    break;
+                }
+            }
+        });
+    }
+    obj.Reset(nullptr);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(destroyed, 1U);
+    ASSERT_TRUE(weak.Expired());
+}
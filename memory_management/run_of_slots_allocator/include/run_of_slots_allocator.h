@@ -1,49 +1,676 @@
 #ifndef MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
 #define MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "base/alignment.h"
 #include "base/macros.h"
+#include "memory_management/common/include/allocator_stats.h"
+#include "memory_management/common/include/os_pages.h"
+#include "memory_management/common/include/page_source.h"
+#include "memory_management/common/include/pool_map.h"
 
 template <size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
-class RunOfSlotsAllocator {
+class ThreadCachedRunOfSlotsAllocator;
+
+/**
+ * @brief Allocates slots of SLOTS_SIZES from pools of ONE_MEM_POOL_SIZE bytes, one pool per size class.
+ * Pools are taken from PageSource (see page_source.h), RunOfSlotsAllocator takes them from the heap
+ */
+template <class PageSource, size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
+class BasicRunOfSlotsAllocator {
     static_assert(sizeof...(SLOTS_SIZES) != 0, "you should set slots sizes");
+    static_assert(((SLOTS_SIZES != 0U) && ...), "slot size can not be zero");
 
-    // here we recommend you to use class MemoryPool to create RunOfSlots for 1 size. Use new to allocate them from heap.
+    // here we recommend you to use class MemoryPool to create RunOfSlots for 1 size.
+    // Use new to allocate them from heap.
     // remember, you can not use any containers with heap allocations
     template <size_t MEM_POOL_SIZE, size_t SLOT_SIZE>
     class RunOfSlotsMemoryPool;
 
+    static constexpr size_t SIZE_CLASSES_COUNT = sizeof...(SLOTS_SIZES);
+
+    // every pool starts with this header and is aligned to PoolAlign(), so masking a slot address gives the header
+    struct PoolHeader {
+        BasicRunOfSlotsAllocator *owner;
+        size_t sizeClass;
+    };
+
 public:
-    RunOfSlotsAllocator() = default;
-    ~RunOfSlotsAllocator() = default;
-    NO_MOVE_SEMANTIC(RunOfSlotsAllocator);
-    NO_COPY_SEMANTIC(RunOfSlotsAllocator);
+    // occupancy of one size class
+    struct SizeClassStats {
+        size_t slotSize = 0U;
+        size_t slotsCount = 0U;
+        size_t usedSlots = 0U;
+    };
 
+    struct Stats : AllocatorStats {
+        std::array<SizeClassStats, SIZE_CLASSES_COUNT> sizeClasses {};
+    };
+
+    BasicRunOfSlotsAllocator() = default;
+    explicit BasicRunOfSlotsAllocator(PageSource source) : source_(source) {}
+    ~BasicRunOfSlotsAllocator()
+    {
+        DestroyPools(std::make_index_sequence<SIZE_CLASSES_COUNT>());
+    }
+    NO_MOVE_SEMANTIC(BasicRunOfSlotsAllocator);
+    NO_COPY_SEMANTIC(BasicRunOfSlotsAllocator);
+
+    // @returns true if some size class can hold T aligned to alignof(T)
+    template <class T>
+    static constexpr bool CanAllocate()
+    {
+        return FindSizeClass(sizeof(T), alignof(T)) != SIZE_CLASSES_COUNT;
+    }
+
+    /**
+     * @brief Allocates a slot of the smallest size which can hold T and is aligned to alignof(T).
+     * The size class is chosen at compile time
+     */
     template <class T = uint8_t>
     T *Allocate()
     {
-        // TODO(you): Add your implementation here...
-        return nullptr;
+        constexpr size_t IDX = FindSizeClass(sizeof(T), alignof(T));
+        if constexpr (IDX == SIZE_CLASSES_COUNT) {
+            STATS_ONLY(counters_.OnAllocate(false));
+            return nullptr;
+        } else {
+            return static_cast<T *>(AllocateFrom<IDX>());
+        }
+    }
+
+    /**
+     * @brief Allocates a slot of the smallest size which can hold T and is aligned to @param align
+     * @param align should be a power of two, alignment less than alignof(T) is raised to alignof(T)
+     */
+    template <class T = uint8_t>
+    T *AllocateAligned(size_t align)
+    {
+        // slots are never aligned to more than a cache line
+        if (UNLIKELY(!IsPowerOfTwo(align) || align > CACHE_LINE_SIZE)) {
+            STATS_ONLY(counters_.OnAllocate(false));
+            return nullptr;
+        }
+        // size classes for sizeof(T) and every possible alignment are known at compile time
+        constexpr auto SIZE_CLASS_BY_ALIGN_SHIFT = SizeClassesByAlignShift<T>();
+        size_t idx = SIZE_CLASS_BY_ALIGN_SHIFT[static_cast<size_t>(__builtin_ctzll(align))];
+        if (UNLIKELY(idx == SIZE_CLASSES_COUNT)) {
+            STATS_ONLY(counters_.OnAllocate(false));
+            return nullptr;
+        }
+        return static_cast<T *>(VisitSizeClass(idx, [this](auto sizeClass) {
+            return AllocateFrom<decltype(sizeClass)::value>();
+        }));
+    }
+
+    /**
+     * @brief Allocates one slot for @param count objects of type T aligned to @param align,
+     * the size class is chosen at runtime
+     * @param align should be a power of two, alignment less than alignof(T) is raised to alignof(T)
+     */
+    template <class T = uint8_t>
+    T *AllocateAligned(size_t count, size_t align)
+    {
+        size_t idx = SIZE_CLASSES_COUNT;
+        if (LIKELY(count != 0U && count <= SIZE_MAX / sizeof(T) && IsPowerOfTwo(align))) {
+            idx = FindSizeClass(count * sizeof(T), align < alignof(T) ? alignof(T) : align);
+        }
+        if (UNLIKELY(idx == SIZE_CLASSES_COUNT)) {
+            STATS_ONLY(counters_.OnAllocate(false));
+            return nullptr;
+        }
+        return static_cast<T *>(VisitSizeClass(idx, [this](auto sizeClass) {
+            return AllocateFrom<decltype(sizeClass)::value>();
+        }));
+    }
+
+    /**
+     * @brief Allocates @param count slots for objects of type T like Allocate() and writes them to @param out.
+     * The size class is resolved once, and free slots are taken from the bitmap a whole word at a time
+     * @returns count of allocated slots, it is less than @param count only if the pool is exhausted
+     */
+    template <class T = uint8_t>
+    size_t AllocateBatch(size_t count, T **out)
+    {
+        constexpr size_t IDX = FindSizeClass(sizeof(T), alignof(T));
+        if constexpr (IDX == SIZE_CLASSES_COUNT) {
+            STATS_ONLY(counters_.OnAllocate(false));
+            return 0U;
+        } else {
+            auto *pool = GetPool<IDX>();
+            size_t allocated = pool == nullptr ? 0U : pool->AllocateBatch(out, count);
+            STATS_ONLY(counters_.OnAllocateBatch(count, allocated));
+            return allocated;
+        }
+    }
+
+    /**
+     * @brief Frees @param count slots from @param ptrs, which should not contain nullptr.
+     * Pool lookup is done once for every run of neighbouring pointers of the same size class
+     */
+    template <class T>
+    void FreeBatch(T *const *ptrs, size_t count)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size_t begin = 0U;
+        while (begin < count) {
+            uintptr_t base = poolMap_.PoolBaseOf(ptrs[begin]);
+            size_t end = begin + 1U;
+            while (end < count && poolMap_.PoolBaseOf(ptrs[end]) == base) {
+                ++end;
+            }
+            VisitSizeClass(SizeClassOf(ptrs[begin]), [this, run = ptrs + begin, size = end - begin](auto sizeClass) {
+                auto *pool = PoolOf<decltype(sizeClass)::value>(run[0]);
+                pool->FreeBatch(run, size);
+                STATS_ONLY(counters_.OnFree(size));
+                if (UNLIKELY(pool->IsEmpty())) {
+                    OnPoolEmptied(decltype(sizeClass)::value);
+                }
+            });
+            begin = end;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     }
 
     void Free(void *ptr)
     {
-        // TODO(you): Add your implementation here...
+        if (ptr == nullptr) {
+            return;
+        }
+        VisitSizeClass(SizeClassOf(ptr), [this, ptr](auto sizeClass) {
+            auto *pool = PoolOf<decltype(sizeClass)::value>(ptr);
+            pool->Free(ptr);
+            STATS_ONLY(counters_.OnFree());
+            if (UNLIKELY(pool->IsEmpty())) {
+                OnPoolEmptied(decltype(sizeClass)::value);
+            }
+        });
+    }
+
+    /**
+     * @brief Gives all empty pools back to the heap. Pools are created again on the next allocation of their size
+     * @returns count of released pools
+     */
+    size_t Trim()
+    {
+        emptyPoolClass_ = SIZE_CLASSES_COUNT;
+        size_t released = 0U;
+        for (size_t idx = 0; idx < SIZE_CLASSES_COUNT; ++idx) {
+            released += ReleaseIfEmpty(idx) ? 1U : 0U;
+        }
+        return released;
+    }
+
+    /**
+     * @brief Checks in O(1) if @param ptr lies in one of the pools, it is safe for any pointer.
+     * Unlike VerifyPtr() the memory may be free
+     */
+    bool OwnsPoolOf(const void *ptr) const
+    {
+        // a pool is smaller than its alignment, so the rest of the aligned range may belong to anyone
+        if (!poolMap_.ContainsPoolOf(ptr)) {
+            return false;
+        }
+        uintptr_t offset = reinterpret_cast<uintptr_t>(ptr) - poolMap_.PoolBaseOf(ptr);
+        return VisitSizeClass(SizeClassOf(ptr),
+                              [offset](auto sizeClass) { return offset < sizeof(PoolAt<decltype(sizeClass)::value>); });
+    }
+
+    // @returns allocator of @param ptr, which should be live memory of any allocator of these sizes
+    static BasicRunOfSlotsAllocator *OwnerOf(const void *ptr)
+    {
+        return reinterpret_cast<const PoolHeader *>(AlignDown(reinterpret_cast<uintptr_t>(ptr), PoolAlign()))->owner;
     }
 
     /**
      * @brief Method should check in @param ptr is pointer to mem from this allocator
      * @returns true if ptr is from this allocator
      */
-    bool VerifyPtr([[maybe_unused]] void *ptr)  // TODO(you): remove [[maybe_unused]]
+    bool VerifyPtr(void *ptr)
+    {
+        // the pool header can be read only after the address is known to be a pool
+        if (!poolMap_.ContainsPoolOf(ptr)) {
+            return false;
+        }
+        return VisitSizeClass(SizeClassOf(ptr), [this, ptr](auto sizeClass) {
+            return PoolOf<decltype(sizeClass)::value>(ptr)->IsAllocated(ptr);
+        });
+    }
+
+#ifdef ALLOCATOR_STATS
+    Stats GetStats() const
+    {
+        Stats stats;
+        stats.reservedBytes = sizeof(BasicRunOfSlotsAllocator);
+        CollectStats(stats, std::make_index_sequence<SIZE_CLASSES_COUNT>());
+        counters_.Finish(stats);
+        return stats;
+    }
+#endif
+
+private:
+    using Pools = std::tuple<RunOfSlotsMemoryPool<ONE_MEM_POOL_SIZE, SLOTS_SIZES> *...>;
+
+    template <size_t IDX>
+    using PoolAt = std::remove_pointer_t<std::tuple_element_t<IDX, Pools>>;
+
+    static constexpr size_t ALIGN_SHIFTS_COUNT = __builtin_ctzll(CACHE_LINE_SIZE) + 1U;
+
+    // @returns index of the smallest size class which fits both @param size and @param align
+    static constexpr size_t FindSizeClass(size_t size, size_t align)
+    {
+        constexpr std::array<size_t, SIZE_CLASSES_COUNT> SIZES {SLOTS_SIZES...};
+        constexpr std::array<size_t, SIZE_CLASSES_COUNT> ALIGNS {
+            RunOfSlotsMemoryPool<ONE_MEM_POOL_SIZE, SLOTS_SIZES>::SLOT_ALIGN...};
+        size_t best = SIZE_CLASSES_COUNT;
+        for (size_t i = 0; i < SIZE_CLASSES_COUNT; ++i) {
+            if (SIZES[i] >= size && ALIGNS[i] >= align && (best == SIZE_CLASSES_COUNT || SIZES[i] < SIZES[best])) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // @returns table of size classes for T indexed by log2 of the requested alignment
+    template <class T>
+    static constexpr std::array<size_t, ALIGN_SHIFTS_COUNT> SizeClassesByAlignShift()
+    {
+        std::array<size_t, ALIGN_SHIFTS_COUNT> classes {};
+        for (size_t shift = 0; shift < ALIGN_SHIFTS_COUNT; ++shift) {
+            size_t align = size_t {1U} << shift;
+            classes[shift] = FindSizeClass(sizeof(T), align < alignof(T) ? alignof(T) : align);
+        }
+        return classes;
+    }
+
+    // all pools have the same power of two alignment which is not less than the biggest pool
+    static constexpr size_t PoolAlign()
+    {
+        size_t maxSize = 0U;
+        ((maxSize = sizeof(RunOfSlotsMemoryPool<ONE_MEM_POOL_SIZE, SLOTS_SIZES>) > maxSize
+                        ? sizeof(RunOfSlotsMemoryPool<ONE_MEM_POOL_SIZE, SLOTS_SIZES>)
+                        : maxSize),
+         ...);
+        return RoundUpToPowerOfTwo(maxSize);
+    }
+
+    // @returns size class of the pool containing @param ptr, which should be from this allocator
+    size_t SizeClassOf(const void *ptr) const
+    {
+        return reinterpret_cast<const PoolHeader *>(poolMap_.PoolBaseOf(ptr))->sizeClass;
+    }
+
+    template <size_t IDX>
+    PoolAt<IDX> *PoolOf(const void *ptr) const
+    {
+        return static_cast<PoolAt<IDX> *>(reinterpret_cast<PoolHeader *>(poolMap_.PoolBaseOf(ptr)));
+    }
+
+    template <class Visitor, size_t IDX>
+    static decltype(auto) VisitSizeClassAt(Visitor &visitor)
+    {
+        return visitor(std::integral_constant<size_t, IDX>());
+    }
+
+    template <class Visitor, size_t... IDX>
+    static constexpr auto MakeVisitTable(std::index_sequence<IDX...> /* unused */)
+    {
+        return std::array {&VisitSizeClassAt<Visitor, IDX>...};
+    }
+
+    /**
+     * @brief Calls @param visitor with std::integral_constant of the size class @param idx known only at runtime.
+     * Dispatch goes through a table of functions, so it takes O(1) for any count of size classes
+     */
+    template <class Visitor>
+    static decltype(auto) VisitSizeClass(size_t idx, Visitor &&visitor)
+    {
+        constexpr auto TABLE = MakeVisitTable<Visitor>(std::make_index_sequence<SIZE_CLASSES_COUNT>());
+        return TABLE[idx](visitor);
+    }
+
+    template <size_t IDX>
+    PoolAt<IDX> *CreatePool()
+    {
+        // only the pool itself is mapped, the alignment is what makes pools found by masking
+        void *mem = source_.Map(sizeof(PoolAt<IDX>), PoolAlign());
+        if (mem == nullptr) {
+            return nullptr;
+        }
+        if (!poolMap_.Insert(reinterpret_cast<uintptr_t>(mem))) {
+            source_.Unmap(mem, sizeof(PoolAt<IDX>), PoolAlign());
+            return nullptr;
+        }
+        return new (mem) PoolAt<IDX>(this, IDX);
+    }
+
+    template <size_t IDX>
+    void DestroyPool()
+    {
+        auto *&pool = std::get<IDX>(pools_);
+        if (pool == nullptr) {
+            return;
+        }
+        poolMap_.Erase(reinterpret_cast<uintptr_t>(pool));
+        pool->~PoolAt<IDX>();
+        source_.Unmap(pool, sizeof(PoolAt<IDX>), PoolAlign());
+        pool = nullptr;
+    }
+
+    // @returns pool of size class IDX, it is created on the first use
+    template <size_t IDX>
+    PoolAt<IDX> *GetPool()
+    {
+        auto *&pool = std::get<IDX>(pools_);
+        if (UNLIKELY(pool == nullptr)) {
+            pool = CreatePool<IDX>();
+        }
+        return pool;
+    }
+
+    template <size_t IDX>
+    void *AllocateFrom()
+    {
+        auto *pool = GetPool<IDX>();
+        void *mem = pool == nullptr ? nullptr : pool->Allocate();
+        STATS_ONLY(counters_.OnAllocate(mem != nullptr));
+        return mem;
+    }
+
+    /**
+     * @brief Allocates up to @param count slots of size class @param idx, @returns count of allocated slots.
+     * Pools are not created here, so only the pool of the size class is touched: a pool which failed to be created
+     * by CreatePools() stays missing, and nothing is allocated from it
+     */
+    size_t AllocateBatchFrom(size_t idx, void **out, size_t count)
+    {
+        return VisitSizeClass(idx, [this, out, count](auto sizeClass) {
+            auto *pool = std::get<decltype(sizeClass)::value>(pools_);
+            return pool == nullptr ? size_t {0U} : pool->AllocateBatch(out, count);
+        });
+    }
+
+    // frees @param count slots of size class @param idx
+    void FreeBatchIn(size_t idx, void *const *ptrs, size_t count)
+    {
+        VisitSizeClass(idx, [this, ptrs, count](auto sizeClass) {
+            std::get<decltype(sizeClass)::value>(pools_)->FreeBatch(ptrs, count);
+        });
+    }
+
+    // @returns true if pool of size class @param idx had no allocated slots and was destroyed
+    bool ReleaseIfEmpty(size_t idx)
+    {
+        return VisitSizeClass(idx, [this](auto sizeClass) {
+            constexpr size_t IDX = decltype(sizeClass)::value;
+            auto *pool = std::get<IDX>(pools_);
+            if (pool == nullptr || !pool->IsEmpty()) {
+                return false;
+            }
+            DestroyPool<IDX>();
+            return true;
+        });
+    }
+
+    // @returns true if pool of size class @param idx had no allocated slots and its pages were released
+    bool ReleasePagesIfEmpty(size_t idx)
+    {
+        return VisitSizeClass(idx, [this](auto sizeClass) {
+            auto *pool = std::get<decltype(sizeClass)::value>(pools_);
+            if (pool == nullptr || !pool->IsEmpty()) {
+                return false;
+            }
+            pool->ReleasePages();
+            return true;
+        });
+    }
+
+    /**
+     * @brief One emptied pool is kept for reuse, so a size class which keeps emptying and refilling its pool
+     * does not recreate it every time. The kept pool is released when a pool of another size class gets empty
+     */
+    void OnPoolEmptied(size_t idx)
+    {
+        if (emptyPoolClass_ != idx && emptyPoolClass_ != SIZE_CLASSES_COUNT) {
+            // the kept pool may have been refilled since then, it is left alone in that case
+            ReleaseIfEmpty(emptyPoolClass_);
+        }
+        emptyPoolClass_ = idx;
+    }
+
+#ifdef ALLOCATOR_STATS
+    template <size_t... IDX>
+    void CollectStats(Stats &stats, std::index_sequence<IDX...> /* unused */) const
+    {
+        (CollectSizeClassStats<IDX>(stats), ...);
+    }
+
+    template <size_t IDX>
+    void CollectSizeClassStats(Stats &stats) const
+    {
+        constexpr std::array<size_t, SIZE_CLASSES_COUNT> SIZES {SLOTS_SIZES...};
+        constexpr size_t SLOT_SIZE = SIZES[IDX];
+        SizeClassStats &sizeClass = stats.sizeClasses[IDX];
+        sizeClass.slotSize = SLOT_SIZE;
+        sizeClass.slotsCount = PoolAt<IDX>::SLOTS_COUNT;
+        const auto *pool = std::get<IDX>(pools_);
+        if (pool == nullptr) {
+            return;
+        }
+        sizeClass.usedSlots = pool->AllocatedCount();
+        ++stats.poolsCount;
+        stats.reservedBytes += sizeof(PoolAt<IDX>);
+        stats.liveBytes += sizeClass.usedSlots * SLOT_SIZE;
+        stats.freeBytes += (sizeClass.slotsCount - sizeClass.usedSlots) * SLOT_SIZE;
+        if (sizeClass.usedSlots != sizeClass.slotsCount && SLOT_SIZE > stats.largestFreeBlock) {
+            stats.largestFreeBlock = SLOT_SIZE;
+        }
+    }
+#endif
+
+    template <size_t... IDX>
+    void CreatePools(std::index_sequence<IDX...> /* unused */)
+    {
+        (GetPool<IDX>(), ...);
+    }
+
+    template <size_t... IDX>
+    void DestroyPools(std::index_sequence<IDX...> /* unused */)
     {
-        // TODO(you): Add your implementation here...
-        return false;
+        (DestroyPool<IDX>(), ...);
+    }
+
+    // pools are created on the first allocation of the size class
+    Pools pools_ {};
+    PoolMap poolMap_ {PoolAlign()};
+    // size class of the emptied pool kept for reuse or SIZE_CLASSES_COUNT
+    size_t emptyPoolClass_ = SIZE_CLASSES_COUNT;
+    PageSource source_ {};
+    STATS_ONLY(AllocatorCounters counters_;)
+
+    friend class ThreadCachedRunOfSlotsAllocator<ONE_MEM_POOL_SIZE, SLOTS_SIZES...>;
+};
+
+/**
+ * @brief Run of MEM_POOL_SIZE / SLOT_SIZE slots of one size placed right after the pool header. Occupancy is kept in
+ * a bitmap, one bit per slot, so slots memory is not touched by the pool. The summary bitmap has one bit per full
+ * bitmap word: finding a free slot takes two bit scans for every 4096 slots.
+ */
+template <class PageSource, size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
+template <size_t MEM_POOL_SIZE, size_t SLOT_SIZE>
+class BasicRunOfSlotsAllocator<PageSource, ONE_MEM_POOL_SIZE, SLOTS_SIZES...>::RunOfSlotsMemoryPool
+    : public PoolHeader {
+    static constexpr size_t BITS_IN_WORD = 64U;
+    static constexpr uint64_t FULL_WORD = ~uint64_t {0U};
+
+public:
+    static constexpr size_t SLOTS_COUNT = MEM_POOL_SIZE / SLOT_SIZE;
+    // every slot is aligned to the biggest power of two dividing the slot size, but not more than a cache line
+    static constexpr size_t SLOT_ALIGN =
+        LowestPowerOfTwoDivisor(SLOT_SIZE) < CACHE_LINE_SIZE ? LowestPowerOfTwoDivisor(SLOT_SIZE) : CACHE_LINE_SIZE;
+
+    RunOfSlotsMemoryPool(BasicRunOfSlotsAllocator *owner, size_t sizeClassIdx) : PoolHeader {owner, sizeClassIdx}
+    {
+        // bits after the last slot are marked as occupied, so they are never found by the bit scan
+        if constexpr (SLOTS_COUNT % BITS_IN_WORD != 0U) {
+            occupied_[WORDS_COUNT - 1U] = FULL_WORD << (SLOTS_COUNT % BITS_IN_WORD);
+        }
+        if constexpr (WORDS_COUNT % BITS_IN_WORD != 0U) {
+            fullWords_[SUMMARY_WORDS_COUNT - 1U] = FULL_WORD << (WORDS_COUNT % BITS_IN_WORD);
+        }
+    }
+    ~RunOfSlotsMemoryPool() = default;
+    NO_COPY_SEMANTIC(RunOfSlotsMemoryPool);
+    NO_MOVE_SEMANTIC(RunOfSlotsMemoryPool);
+
+    void *Allocate()
+    {
+        for (size_t summary = summaryHint_; summary < SUMMARY_WORDS_COUNT; ++summary) {
+            uint64_t notFull = ~fullWords_[summary];
+            if (notFull == 0U) {
+                continue;
+            }
+            summaryHint_ = summary;
+            size_t word = summary * BITS_IN_WORD + static_cast<size_t>(__builtin_ctzll(notFull));
+            size_t bit = static_cast<size_t>(__builtin_ctzll(~occupied_[word]));
+            occupied_[word] |= uint64_t {1U} << bit;
+            if (occupied_[word] == FULL_WORD) {
+                fullWords_[summary] |= uint64_t {1U} << (word % BITS_IN_WORD);
+            }
+            ++allocatedCount_;
+            return SlotAt(word * BITS_IN_WORD + bit);
+        }
+        summaryHint_ = SUMMARY_WORDS_COUNT;
+        return nullptr;
+    }
+
+    // @returns count of slots written to @param out, it is less than @param count only if the pool is full
+    template <class T>
+    size_t AllocateBatch(T **out, size_t count)
+    {
+        size_t allocated = 0U;
+        size_t summary = summaryHint_;
+        for (; summary < SUMMARY_WORDS_COUNT && allocated < count; ++summary) {
+            uint64_t notFull = ~fullWords_[summary];
+            while (notFull != 0U && allocated < count) {
+                size_t word = summary * BITS_IN_WORD + static_cast<size_t>(__builtin_ctzll(notFull));
+                uint64_t free = ~occupied_[word];
+                // take the whole word at once if the batch needs it
+                while (free != 0U && allocated < count) {
+                    size_t bit = static_cast<size_t>(__builtin_ctzll(free));
+                    free &= free - 1U;
+                    occupied_[word] |= uint64_t {1U} << bit;
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    out[allocated++] = static_cast<T *>(SlotAt(word * BITS_IN_WORD + bit));
+                }
+                if (free != 0U) {
+                    break;
+                }
+                fullWords_[summary] |= uint64_t {1U} << (word % BITS_IN_WORD);
+                notFull &= notFull - 1U;
+            }
+            if (notFull != 0U) {
+                break;
+            }
+        }
+        summaryHint_ = summary;
+        allocatedCount_ += allocated;
+        return allocated;
+    }
+
+    template <class T>
+    void FreeBatch(T *const *ptrs, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            Free(ptrs[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    void Free(void *ptr)
+    {
+        size_t idx = SlotIndex(ptr);
+        size_t word = idx / BITS_IN_WORD;
+        // double free or pointer inside a slot
+        assert(IsAllocated(ptr));
+        occupied_[word] &= ~(uint64_t {1U} << (idx % BITS_IN_WORD));
+        fullWords_[word / BITS_IN_WORD] &= ~(uint64_t {1U} << (word % BITS_IN_WORD));
+        if (word / BITS_IN_WORD < summaryHint_) {
+            summaryHint_ = word / BITS_IN_WORD;
+        }
+        --allocatedCount_;
+    }
+
+    bool IsEmpty() const
+    {
+        return allocatedCount_ == 0U;
+    }
+
+    size_t AllocatedCount() const
+    {
+        return allocatedCount_;
+    }
+
+    /**
+     * @brief Gives physical pages of the slots back to the OS, the pool stays usable. Should be called only for
+     * an empty pool
+     */
+    void ReleasePages()
+    {
+        assert(IsEmpty());
+        ::ReleasePages(slots_.data(), slots_.size());
+    }
+
+    bool Contains(const void *ptr) const
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        auto begin = reinterpret_cast<uintptr_t>(slots_.data());
+        return addr >= begin && addr < begin + SLOTS_COUNT * SLOT_SIZE;
+    }
+
+    // @returns true if @param ptr points to the beginning of a currently allocated slot of this pool
+    bool IsAllocated(const void *ptr) const
+    {
+        if (!Contains(ptr)) {
+            return false;
+        }
+        size_t offset = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(slots_.data());
+        if (offset % SLOT_SIZE != 0U) {
+            return false;
+        }
+        size_t idx = offset / SLOT_SIZE;
+        return (occupied_[idx / BITS_IN_WORD] & (uint64_t {1U} << (idx % BITS_IN_WORD))) != 0U;
     }
 
 private:
-    // TODO(you): Add your fields and methods here...
+    static constexpr size_t WORDS_COUNT = (SLOTS_COUNT + BITS_IN_WORD - 1U) / BITS_IN_WORD;
+    static constexpr size_t SUMMARY_WORDS_COUNT = (WORDS_COUNT + BITS_IN_WORD - 1U) / BITS_IN_WORD;
+
+    void *SlotAt(size_t idx)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return slots_.data() + idx * SLOT_SIZE;
+    }
+
+    size_t SlotIndex(const void *ptr) const
+    {
+        return (reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(slots_.data())) / SLOT_SIZE;
+    }
+
+    // no free slots are in summary words before the hint
+    size_t summaryHint_ = 0U;
+    size_t allocatedCount_ = 0U;
+    std::array<uint64_t, SUMMARY_WORDS_COUNT> fullWords_ {};
+    std::array<uint64_t, WORDS_COUNT> occupied_ {};
+    alignas(SLOT_ALIGN) std::array<uint8_t, MEM_POOL_SIZE> slots_;  // NOLINT(cppcoreguidelines-pro-type-member-init)
 };
 
-#endif  // MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
\ No newline at end of file
+template <size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
+using RunOfSlotsAllocator = BasicRunOfSlotsAllocator<NewPageSource, ONE_MEM_POOL_SIZE, SLOTS_SIZES...>;
+
+#endif  // MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_RUN_OF_SLOTS_ALLOCATOR_H
@@ -0,0 +1,165 @@
+#ifndef MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_THREAD_CACHED_RUN_OF_SLOTS_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_THREAD_CACHED_RUN_OF_SLOTS_ALLOCATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include "base/alignment.h"
+#include "base/macros.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
+
+/**
+ * @brief Concurrent front end for RunOfSlotsAllocator.
+ * Every thread creates its own ThreadCache which keeps a magazine of free slots per size class. Allocate and Free
+ * work with the magazine only; the central pools are locked when a magazine is empty or full, and then BATCH_SIZE
+ * slots are moved at once.
+ */
+template <size_t ONE_MEM_POOL_SIZE, size_t... SLOTS_SIZES>
+class ThreadCachedRunOfSlotsAllocator {
+    using CentralAllocator = RunOfSlotsAllocator<ONE_MEM_POOL_SIZE, SLOTS_SIZES...>;
+
+    static constexpr size_t SIZE_CLASSES_COUNT = sizeof...(SLOTS_SIZES);
+
+public:
+    static constexpr size_t MAGAZINE_SIZE = 64U;
+    static constexpr size_t BATCH_SIZE = MAGAZINE_SIZE / 2U;
+
+    /**
+     * @brief Slots cache which should be used by one thread only. Cached slots go back to the central pools
+     * on Flush() and on destruction
+     */
+    class ThreadCache {
+    public:
+        explicit ThreadCache(ThreadCachedRunOfSlotsAllocator &allocator) : allocator_(allocator) {}
+        ~ThreadCache()
+        {
+            Flush();
+        }
+        NO_COPY_SEMANTIC(ThreadCache);
+        NO_MOVE_SEMANTIC(ThreadCache);
+
+        template <class T = uint8_t>
+        T *Allocate()
+        {
+            constexpr size_t IDX = CentralAllocator::FindSizeClass(sizeof(T), alignof(T));
+            if constexpr (IDX == SIZE_CLASSES_COUNT) {
+                return nullptr;
+            } else {
+                Magazine &magazine = magazines_[IDX];
+                if (UNLIKELY(magazine.count == 0U)) {
+                    magazine.count = allocator_.AllocateBatchFrom(IDX, magazine.slots.data(), BATCH_SIZE);
+                    if (magazine.count == 0U) {
+                        return nullptr;
+                    }
+                }
+                return static_cast<T *>(magazine.slots[--magazine.count]);
+            }
+        }
+
+        /**
+         * @brief Frees @param ptr allocated by any thread
+         */
+        void Free(void *ptr)
+        {
+            if (ptr == nullptr) {
+                return;
+            }
+            size_t idx = allocator_.central_.SizeClassOf(ptr);
+            Magazine &magazine = magazines_[idx];
+            if (UNLIKELY(magazine.count == MAGAZINE_SIZE)) {
+                magazine.count -= BATCH_SIZE;
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                allocator_.FreeBatchIn(idx, magazine.slots.data() + magazine.count, BATCH_SIZE);
+            }
+            magazine.slots[magazine.count++] = ptr;
+        }
+
+        /**
+         * @brief Returns all cached slots to the central pools
+         */
+        void Flush()
+        {
+            for (size_t idx = 0; idx < SIZE_CLASSES_COUNT; ++idx) {
+                Magazine &magazine = magazines_[idx];
+                if (magazine.count != 0U) {
+                    allocator_.FreeBatchIn(idx, magazine.slots.data(), magazine.count);
+                    magazine.count = 0U;
+                }
+            }
+        }
+
+    private:
+        struct Magazine {
+            size_t count = 0U;
+            std::array<void *, MAGAZINE_SIZE> slots {};
+        };
+
+        ThreadCachedRunOfSlotsAllocator &allocator_;
+        std::array<Magazine, SIZE_CLASSES_COUNT> magazines_ {};
+    };
+
+    ThreadCachedRunOfSlotsAllocator()
+    {
+        // pools never change after this point, so the pool map and pool headers are read without locks.
+        // A pool which can not be created is never retried: size class of it just has no memory
+        central_.CreatePools(std::make_index_sequence<SIZE_CLASSES_COUNT>());
+    }
+    ~ThreadCachedRunOfSlotsAllocator() = default;
+    NO_COPY_SEMANTIC(ThreadCachedRunOfSlotsAllocator);
+    NO_MOVE_SEMANTIC(ThreadCachedRunOfSlotsAllocator);
+
+    /**
+     * @brief Method should check in @param ptr is pointer to mem from this allocator.
+     * Slots cached by threads are reported as allocated
+     * @returns true if ptr is from this allocator
+     */
+    bool VerifyPtr(void *ptr)
+    {
+        if (!central_.poolMap_.ContainsPoolOf(ptr)) {
+            return false;
+        }
+        size_t idx = central_.SizeClassOf(ptr);
+        std::lock_guard<std::mutex> lock(locks_[idx].mutex);
+        return central_.VerifyPtr(ptr);
+    }
+
+    /**
+     * @brief Gives physical pages of empty pools back to the OS. Pools themselves are never destroyed, as they are
+     * read without locks. Slots cached by threads keep their pools from being empty, so caches should be flushed first
+     * @returns count of pools whose pages were released
+     */
+    size_t Trim()
+    {
+        size_t released = 0U;
+        for (size_t idx = 0; idx < SIZE_CLASSES_COUNT; ++idx) {
+            std::lock_guard<std::mutex> lock(locks_[idx].mutex);
+            released += central_.ReleasePagesIfEmpty(idx) ? 1U : 0U;
+        }
+        return released;
+    }
+
+private:
+    size_t AllocateBatchFrom(size_t idx, void **out, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(locks_[idx].mutex);
+        return central_.AllocateBatchFrom(idx, out, count);
+    }
+
+    void FreeBatchIn(size_t idx, void *const *ptrs, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(locks_[idx].mutex);
+        central_.FreeBatchIn(idx, ptrs, count);
+    }
+
+    // every lock is on its own cache line, so threads working with different size classes do not interfere
+    struct alignas(CACHE_LINE_SIZE) SizeClassLock {
+        std::mutex mutex;
+    };
+
+    CentralAllocator central_;
+    std::array<SizeClassLock, SIZE_CLASSES_COUNT> locks_ {};
+};
+
+#endif  // MEMORY_MANAGEMENT_RUN_OF_SLOTS_ALLOCATOR_INCLUDE_THREAD_CACHED_RUN_OF_SLOTS_ALLOCATOR_H
@@ -1,9 +1,17 @@
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+#include "memory_management/common/include/node_local_allocator.h"
+#include "memory_management/common/include/stl_adapters.h"
 #include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
 
-TEST(RunOfSlotsAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABLED_ prefix to use test
+TEST(RunOfSlotsAllocatorTest, TemplateAllocationTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 4048U;
     RunOfSlotsAllocator<MEMORY_POOL_SIZE, 1U, 2U, 4U, 8U> allocator;
@@ -27,7 +35,7 @@ TEST(RunOfSlotsAllocatorTest, DISABLED_TemplateAllocationTest)  // remove DISABL
     allocator.Free(int1);
 }
 
-TEST(RunOfSlotsAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove DISABLED_ prefix to use test
+TEST(RunOfSlotsAllocatorTest, AllocatorMemPoolOverflowTest)
 {
     constexpr size_t MEMORY_POOL_SIZE = 8U;
     RunOfSlotsAllocator<MEMORY_POOL_SIZE, 1U, 2U, 4U, 8U> allocator;
@@ -46,4 +54,286 @@ TEST(RunOfSlotsAllocatorTest, DISABLED_AllocatorMemPoolOverflowTest)  // remove
 
     allocator.Free(mem);
     allocator.Free(memInt);
-}
\ No newline at end of file
+}
+TEST(RunOfSlotsAllocatorTest, AlignmentTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 24U, 32U, 64U> allocator;
+
+    struct alignas(16U) Vec2 {
+        double x;
+        double y;
+    };
+    // 24-byte slots are only 8-byte aligned, so 32-byte slots are used
+    for (size_t i = 0; i < 3U; ++i) {
+        auto *vec = allocator.Allocate<Vec2>();
+        ASSERT_NE(vec, nullptr);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(vec) % alignof(Vec2), 0U);
+    }
+
+    constexpr size_t AVX_ALIGN = 32U;
+    auto *avx = allocator.AllocateAligned<double>(AVX_ALIGN);
+    ASSERT_NE(avx, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(avx) % AVX_ALIGN, 0U);
+
+    auto *line = allocator.AllocateAligned<size_t>(CACHE_LINE_SIZE);
+    ASSERT_NE(line, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(line) % CACHE_LINE_SIZE, 0U);
+
+    constexpr size_t TOO_BIG_ALIGN = 128U;
+    ASSERT_EQ(allocator.AllocateAligned<size_t>(TOO_BIG_ALIGN), nullptr);  // no slots are aligned so much
+    ASSERT_EQ(allocator.AllocateAligned<size_t>(3U), nullptr);             // alignment should be a power of two
+}
+
+TEST(RunOfSlotsAllocatorTest, ManySizeClassesTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    // size classes are not sorted on purpose
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 128U, 8U, 16U, 24U, 32U, 40U, 48U, 56U, 64U, 80U, 96U, 112U, 12U, 160U,
+                        192U, 256U>
+        allocator;
+
+    struct Record {
+        std::array<char, 20U> data;
+    };
+    auto *first = allocator.Allocate<Record>();
+    auto *second = allocator.Allocate<Record>();
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(size_t(second) - size_t(first), 24U);  // the smallest fitting class is used
+
+    struct Big {
+        std::array<char, 150U> data;
+    };
+    auto *big1 = allocator.Allocate<Big>();
+    auto *big2 = allocator.Allocate<Big>();
+    ASSERT_EQ(size_t(big2) - size_t(big1), 160U);
+
+    struct Huge {
+        std::array<char, 257U> data;
+    };
+    ASSERT_EQ(allocator.Allocate<Huge>(), nullptr);  // no size class for it
+
+    allocator.Free(first);
+    allocator.Free(second);
+    allocator.Free(big1);
+    allocator.Free(big2);
+}
+
+TEST(RunOfSlotsAllocatorTest, SlotBitmapTest)
+{
+    // more than 4096 slots, so the summary bitmap has several words
+    constexpr size_t MEMORY_POOL_SIZE = 5000U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 1U> allocator;
+
+    auto *first = allocator.Allocate<char>();
+    ASSERT_NE(first, nullptr);
+    for (size_t i = 1U; i < MEMORY_POOL_SIZE; ++i) {
+        auto *mem = allocator.Allocate<char>();
+        ASSERT_EQ(mem, first + i);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    ASSERT_EQ(allocator.Allocate<char>(), nullptr);
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    constexpr size_t LATE_SLOT = 4500U;
+    constexpr size_t EARLY_SLOT = 100U;
+    allocator.Free(first + LATE_SLOT);
+    allocator.Free(first + EARLY_SLOT);
+    ASSERT_FALSE(allocator.VerifyPtr(first + EARLY_SLOT));  // freed slots do not pass verification
+    ASSERT_TRUE(allocator.VerifyPtr(first + EARLY_SLOT + 1U));
+    ASSERT_EQ(allocator.Allocate<char>(), first + EARLY_SLOT);  // the lowest free slot is taken first
+    ASSERT_EQ(allocator.Allocate<char>(), first + LATE_SLOT);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT_EQ(allocator.Allocate<char>(), nullptr);
+}
+
+TEST(RunOfSlotsAllocatorTest, VerifyPtrTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 64U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 16U> allocator;
+
+    struct Pair {
+        size_t first;
+        size_t second;
+    };
+    auto *pair = allocator.Allocate<Pair>();
+    ASSERT_TRUE(allocator.VerifyPtr(pair));
+    ASSERT_FALSE(allocator.VerifyPtr(&pair->second));  // not a slot boundary
+    ASSERT_FALSE(allocator.VerifyPtr(pair + 1U));      // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    allocator.Free(pair);
+    ASSERT_FALSE(allocator.VerifyPtr(pair));
+}
+
+TEST(RunOfSlotsAllocatorTest, ForeignPtrTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4048U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 16U> allocator;
+
+    auto *mem = allocator.Allocate<size_t>();
+    ASSERT_TRUE(allocator.VerifyPtr(mem));
+    size_t onStack = 0;
+    auto heap = std::make_unique<size_t>(0U);
+    ASSERT_FALSE(allocator.VerifyPtr(&onStack));
+    ASSERT_FALSE(allocator.VerifyPtr(heap.get()));
+    ASSERT_FALSE(allocator.VerifyPtr(nullptr));
+    allocator.Free(mem);
+}
+
+TEST(RunOfSlotsAllocatorTest, TrimTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 16U> allocator;
+
+    auto *small = allocator.Allocate<uint64_t>();
+    auto *big = allocator.Allocate<std::array<uint64_t, 2U>>();
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(big, nullptr);
+    allocator.Free(small);
+    ASSERT_EQ(allocator.Allocate<uint64_t>(), small);  // the emptied pool is kept
+
+    allocator.Free(small);
+    allocator.Free(big);  // only the last emptied pool is kept
+    ASSERT_EQ(allocator.Trim(), 1U);
+    ASSERT_EQ(allocator.Trim(), 0U);
+    ASSERT_FALSE(allocator.VerifyPtr(big));
+
+    // pools are created again on demand
+    small = allocator.Allocate<uint64_t>();
+    ASSERT_NE(small, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(small));
+    ASSERT_EQ(allocator.Trim(), 0U);
+    allocator.Free(small);
+    ASSERT_EQ(allocator.Trim(), 1U);
+}
+
+TEST(RunOfSlotsAllocatorTest, BatchTest)
+{
+    constexpr size_t SLOTS_COUNT = 200U;
+    RunOfSlotsAllocator<SLOTS_COUNT * sizeof(uint64_t), 8U, 16U> allocator;
+
+    std::vector<uint64_t *> batch(SLOTS_COUNT + 1U);
+    ASSERT_EQ(allocator.AllocateBatch(SLOTS_COUNT + 1U, batch.data()), SLOTS_COUNT);
+    batch.pop_back();
+    std::vector<uint64_t *> sorted(batch);
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    for (auto *mem : batch) {
+        ASSERT_TRUE(allocator.VerifyPtr(mem));
+    }
+
+    // pointers of different size classes can be mixed
+    std::vector<void *> mixed(batch.begin(), batch.end());
+    mixed.insert(mixed.begin() + SLOTS_COUNT / 2U, allocator.Allocate<std::array<uint64_t, 2U>>());
+    allocator.FreeBatch(mixed.data(), mixed.size());
+    for (auto *mem : mixed) {
+        ASSERT_FALSE(allocator.VerifyPtr(mem));
+    }
+    ASSERT_EQ(allocator.AllocateBatch(SLOTS_COUNT, batch.data()), SLOTS_COUNT);
+}
+
+TEST(RunOfSlotsAllocatorTest, HugePageSourceTest)
+{
+    // every pool takes one huge page
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 20U;
+    BasicRunOfSlotsAllocator<HugePageSource, MEMORY_POOL_SIZE, 8U, 64U> allocator;
+
+    auto *small = allocator.Allocate<uint64_t>();
+    auto *big = allocator.Allocate<std::array<uint64_t, 8U>>();
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(big, nullptr);
+    ASSERT_TRUE(allocator.VerifyPtr(small));
+    ASSERT_TRUE(allocator.VerifyPtr(big));
+    allocator.Free(small);
+    allocator.Free(big);
+    allocator.Trim();
+    ASSERT_FALSE(allocator.VerifyPtr(small));
+    ASSERT_NE(allocator.Allocate<uint64_t>(), nullptr);
+}
+
+TEST(RunOfSlotsAllocatorTest, NodeLocalAllocatorTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    NodeLocalAllocator<BasicRunOfSlotsAllocator<NumaPageSource, MEMORY_POOL_SIZE, 8U, 16U>> allocator;
+
+    auto *small = allocator.Allocate<uint64_t>();
+    auto *big = allocator.Allocate<std::array<uint64_t, 2U>>();
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(big, nullptr);
+    ASSERT_TRUE(allocator.GetNodeAllocator(CurrentNumaNode()).VerifyPtr(small));
+    allocator.Free(small);
+    allocator.Free(big);
+    ASSERT_FALSE(allocator.VerifyPtr(small));
+    ASSERT_FALSE(allocator.VerifyPtr(big));
+
+    // memory of every node is given back to its own allocator
+    for (size_t node = 0; node < allocator.NodesCount(); ++node) {
+        auto *mem = allocator.GetNodeAllocator(node).Allocate<uint64_t>();
+        ASSERT_NE(mem, nullptr);
+        allocator.Free(mem);
+        ASSERT_FALSE(allocator.GetNodeAllocator(node).VerifyPtr(mem));
+    }
+}
+
+TEST(RunOfSlotsAllocatorTest, StlAllocatorTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1U << 16U;
+    constexpr int COUNT = 1000;
+    // nodes of std::list and std::map fit the slots, their size classes are chosen at runtime
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 32U, 48U, 64U>;
+    Allocator allocator;
+    {
+        std::list<int, StlAllocator<int, Allocator>> list {StlAllocator<int, Allocator>(allocator)};
+        using MapAllocator = StlAllocator<std::pair<const int, int>, Allocator>;
+        std::map<int, int, std::less<>, MapAllocator> map {MapAllocator(allocator)};
+        for (int i = 0; i < COUNT; ++i) {
+            list.push_back(i);
+            map.emplace(i, -i);
+        }
+        ASSERT_EQ(list.size(), COUNT);
+        ASSERT_EQ(map.at(COUNT - 1), 1 - COUNT);
+        ASSERT_EQ(list.get_allocator(), map.get_allocator());
+    }
+    // containers give all memory back, only the last emptied pool is kept
+    ASSERT_EQ(allocator.Trim(), 1U);
+
+    // arrays do not fit any slot
+    AllocatorMemoryResource resource(allocator);
+    std::pmr::vector<int> small({1, 2, 3}, &resource);
+    ASSERT_TRUE(allocator.VerifyPtr(small.data()));
+    ASSERT_THROW(small.resize(COUNT), std::bad_alloc);
+}
+
+TEST(RunOfSlotsAllocatorTest, OwnsPoolOfTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    constexpr size_t SLOT_SIZE = 64U;
+    using Slot = std::array<uint8_t, SLOT_SIZE>;
+    RunOfSlotsAllocator<MEMORY_POOL_SIZE, SLOT_SIZE> allocator;
+
+    uint8_t *last = nullptr;
+    for (size_t i = 0; i < MEMORY_POOL_SIZE / SLOT_SIZE; ++i) {
+        auto *slot = reinterpret_cast<uint8_t *>(allocator.Allocate<Slot>());
+        ASSERT_NE(slot, nullptr);
+        ASSERT_TRUE(allocator.OwnsPoolOf(slot));
+        last = std::max(last, slot);
+    }
+    ASSERT_TRUE(allocator.OwnsPoolOf(last + SLOT_SIZE - 1U));
+    // the pool is aligned to twice its size, the rest of the aligned range is not a part of it
+    ASSERT_FALSE(allocator.OwnsPoolOf(last + 2U * SLOT_SIZE));
+}
+
+TEST(RunOfSlotsAllocatorTest, OwnerOfTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 64U>;
+    Allocator first;
+    Allocator second;
+
+    // the owner is read from the pool header, every size class has its own pool
+    auto *small = first.Allocate<uint64_t>();
+    auto *big = first.Allocate<std::array<uint64_t, 8U>>();
+    auto *other = second.Allocate<uint64_t>();
+    ASSERT_EQ(Allocator::OwnerOf(small), &first);
+    ASSERT_EQ(Allocator::OwnerOf(big), &first);
+    ASSERT_EQ(Allocator::OwnerOf(other), &second);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
+
+#ifndef ALLOCATOR_STATS
+#error "statistics tests should be built with ALLOCATOR_STATS"
+#endif
+
+TEST(RunOfSlotsAllocatorStatsTest, GetStatsTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 1024U;
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 16U, 32U>;
+    Allocator allocator;
+
+    auto *small = allocator.Allocate<uint64_t>();
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE((allocator.Allocate<std::array<uint64_t, 2U>>()), nullptr);
+    ASSERT_EQ((allocator.Allocate<std::array<uint64_t, 8U>>()), nullptr);  // no size class
+    allocator.Free(small);
+    Allocator::Stats stats = allocator.GetStats();
+    ASSERT_EQ(stats.allocations, 2U);
+    ASSERT_EQ(stats.frees, 1U);
+    ASSERT_EQ(stats.failures, 1U);
+    ASSERT_EQ(stats.poolsCount, 2U);
+    ASSERT_EQ(stats.liveBytes, 16U);
+    ASSERT_EQ(stats.largestFreeBlock, 16U);  // pool of 32 byte slots is not created yet
+    ASSERT_EQ(stats.freeBytes, MEMORY_POOL_SIZE - 16U + MEMORY_POOL_SIZE);
+
+    ASSERT_EQ(stats.sizeClasses[0].slotSize, 8U);
+    ASSERT_EQ(stats.sizeClasses[0].slotsCount, MEMORY_POOL_SIZE / 8U);
+    ASSERT_EQ(stats.sizeClasses[0].usedSlots, 0U);
+    ASSERT_EQ(stats.sizeClasses[1].usedSlots, 1U);
+    ASSERT_EQ(stats.sizeClasses[2].slotSize, 32U);
+    ASSERT_EQ(stats.sizeClasses[2].usedSlots, 0U);
+}
+
+TEST(RunOfSlotsAllocatorStatsTest, ReservedBytesTest)
+{
+    // the pool header makes pools a bit bigger than a power of two, but only the pool is reserved, not its alignment
+    constexpr size_t MEMORY_POOL_SIZE = 64U * 1024U;
+    using Allocator = RunOfSlotsAllocator<MEMORY_POOL_SIZE, 64U>;
+    Allocator allocator;
+
+    ASSERT_NE((allocator.Allocate<std::array<uint64_t, 8U>>()), nullptr);
+    Allocator::Stats stats = allocator.GetStats();
+    ASSERT_GT(stats.reservedBytes, MEMORY_POOL_SIZE);
+    ASSERT_LT(stats.reservedBytes, MEMORY_POOL_SIZE + MEMORY_POOL_SIZE / 8U);
+}
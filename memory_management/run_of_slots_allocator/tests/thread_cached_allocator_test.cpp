@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "memory_management/run_of_slots_allocator/include/thread_cached_run_of_slots_allocator.h"
+
+TEST(ThreadCachedRunOfSlotsAllocatorTest, SingleThreadTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    using Allocator = ThreadCachedRunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 16U>;
+    Allocator allocator;
+
+    size_t *mem = nullptr;
+    {
+        Allocator::ThreadCache cache(allocator);
+        mem = cache.Allocate<size_t>();
+        ASSERT_NE(mem, nullptr);
+        ASSERT_TRUE(allocator.VerifyPtr(mem));
+        cache.Free(mem);
+        ASSERT_EQ(cache.Allocate<size_t>(), mem);  // the magazine is LIFO
+        cache.Free(mem);
+        ASSERT_TRUE(allocator.VerifyPtr(mem));  // cached slots are still owned by the thread
+    }
+    ASSERT_FALSE(allocator.VerifyPtr(mem));  // cache is flushed on destruction
+}
+
+TEST(ThreadCachedRunOfSlotsAllocatorTest, BatchTransferTest)
+{
+    constexpr size_t SLOTS_COUNT = 256U;
+    using Allocator = ThreadCachedRunOfSlotsAllocator<SLOTS_COUNT * sizeof(size_t), 8U>;
+    Allocator allocator;
+    Allocator::ThreadCache cache(allocator);
+
+    std::vector<size_t *> allocated;
+    for (size_t i = 0; i < SLOTS_COUNT; ++i) {
+        auto *mem = cache.Allocate<size_t>();
+        ASSERT_NE(mem, nullptr);
+        allocated.push_back(mem);
+    }
+    ASSERT_EQ(cache.Allocate<size_t>(), nullptr);
+
+    // frees overflow the magazine and go back to the central pool in batches
+    for (auto *mem : allocated) {
+        cache.Free(mem);
+    }
+    size_t freeInCentral = 0;
+    for (auto *mem : allocated) {
+        freeInCentral += allocator.VerifyPtr(mem) ? 0U : 1U;
+    }
+    ASSERT_GE(freeInCentral, SLOTS_COUNT - Allocator::MAGAZINE_SIZE);
+
+    Allocator::ThreadCache other(allocator);
+    for (size_t i = 0; i < SLOTS_COUNT - Allocator::MAGAZINE_SIZE; ++i) {
+        ASSERT_NE(other.Allocate<size_t>(), nullptr);
+    }
+}
+
+TEST(ThreadCachedRunOfSlotsAllocatorTest, CrossThreadFreeTest)
+{
+    constexpr size_t THREADS_COUNT = 4U;
+    constexpr size_t ALLOCS_PER_THREAD = 1000U;
+    using Allocator = ThreadCachedRunOfSlotsAllocator<THREADS_COUNT * ALLOCS_PER_THREAD * sizeof(size_t), 8U>;
+    Allocator allocator;
+
+    std::array<std::vector<size_t *>, THREADS_COUNT> allocated;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&allocator, &ptrs = allocated[i], i]() {
+            Allocator::ThreadCache cache(allocator);
+            for (size_t j = 0; j < ALLOCS_PER_THREAD; ++j) {
+                auto *mem = cache.Allocate<size_t>();
+                ASSERT_NE(mem, nullptr);
+                *mem = i;
+                ptrs.push_back(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    std::vector<size_t *> all;
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        for (auto *mem : allocated[i]) {
+            ASSERT_EQ(*mem, i);
+            all.push_back(mem);
+        }
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+
+    // every thread frees slots allocated by its neighbour
+    for (size_t i = 0; i < THREADS_COUNT; ++i) {
+        threads.emplace_back([&allocator, &ptrs = allocated[(i + 1U) % THREADS_COUNT]]() {
+            Allocator::ThreadCache cache(allocator);
+            for (auto *mem : ptrs) {
+                cache.Free(mem);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto *mem : all) {
+        ASSERT_FALSE(allocator.VerifyPtr(mem));
+    }
+}
+
+TEST(ThreadCachedRunOfSlotsAllocatorTest, TrimTest)
+{
+    constexpr size_t MEMORY_POOL_SIZE = 4096U;
+    using Allocator = ThreadCachedRunOfSlotsAllocator<MEMORY_POOL_SIZE, 8U, 16U>;
+    Allocator allocator;
+    Allocator::ThreadCache cache(allocator);
+
+    auto *mem = cache.Allocate<size_t>();
+    ASSERT_NE(mem, nullptr);
+    ASSERT_EQ(allocator.Trim(), 1U);  // the other pool is empty
+    *mem = 1U;
+    cache.Free(mem);
+    ASSERT_EQ(allocator.Trim(), 1U);  // the freed slot is still cached
+    cache.Flush();
+    ASSERT_EQ(allocator.Trim(), 2U);
+
+    // released pools stay usable
+    mem = cache.Allocate<size_t>();
+    ASSERT_NE(mem, nullptr);
+    *mem = 2U;
+    ASSERT_TRUE(allocator.VerifyPtr(mem));
+    cache.Free(mem);
+}
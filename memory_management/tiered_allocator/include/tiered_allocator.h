@@ -0,0 +1,120 @@
+#ifndef MEMORY_MANAGEMENT_TIERED_ALLOCATOR_INCLUDE_TIERED_ALLOCATOR_H
+#define MEMORY_MANAGEMENT_TIERED_ALLOCATOR_INCLUDE_TIERED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "base/macros.h"
+
+// How long allocated memory lives, it tells TieredAllocator which backend to use
+enum class Lifetime {
+    // freed one by one with Free()
+    GENERAL,
+    // freed all at once with the end of the request by ResetArena()
+    REQUEST,
+};
+
+/**
+ * @brief Front end routing allocations to three backends:
+ * - single objects of small fixed sizes go to SmallAllocator (e.g. RunOfSlotsAllocator)
+ * - other general allocations and small ones which do not fit SmallAllocator go to MediumAllocator
+ *   (e.g. FreeListAllocator)
+ * - allocations of Lifetime::REQUEST go to the ArenaAllocator (e.g. BumpPointerAllocator)
+ * Free() finds the backend in O(1) through pool maps of SmallAllocator and MediumAllocator, which should provide
+ * OwnsPoolOf(). Arena memory is freed only by ResetArena(), Free() ignores it.
+ */
+template <class SmallAllocator, class MediumAllocator, class ArenaAllocator>
+class TieredAllocator {
+public:
+    TieredAllocator() = default;
+    ~TieredAllocator() = default;
+    NO_COPY_SEMANTIC(TieredAllocator);
+    NO_MOVE_SEMANTIC(TieredAllocator);
+
+    /**
+     * @brief Allocates memory for @param count objects of type T aligned to alignof(T) from the backend chosen by
+     * the size and @param lifetime
+     */
+    template <class T = uint8_t>
+    T *Allocate(size_t count = 1U, Lifetime lifetime = Lifetime::GENERAL)
+    {
+        if (lifetime == Lifetime::REQUEST) {
+            return arena_.template Allocate<T>(count);
+        }
+        if constexpr (SmallAllocator::template CanAllocate<T>()) {
+            if (count == 1U) {
+                T *mem = small_.template Allocate<T>();
+                if (LIKELY(mem != nullptr)) {
+                    return mem;
+                }
+            }
+        }
+        return medium_.template Allocate<T>(count);
+    }
+
+    /**
+     * @brief Frees @param ptr allocated with Lifetime::GENERAL, memory of the arena is left till ResetArena().
+     * @param ptr should be nullptr or memory of this allocator
+     */
+    void Free(void *ptr)
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (small_.OwnsPoolOf(ptr)) {
+            small_.Free(ptr);
+            return;
+        }
+        if (medium_.OwnsPoolOf(ptr)) {
+            medium_.Free(ptr);
+            return;
+        }
+        // arena memory is freed with the whole arena, any other pointer is misrouted
+        assert(arena_.VerifyPtr(ptr));
+    }
+
+    /**
+     * @brief Method should check in @param ptr is pointer to mem from this allocator
+     * @returns true if ptr is from this allocator
+     */
+    bool VerifyPtr(void *ptr)
+    {
+        if (small_.OwnsPoolOf(ptr)) {
+            return small_.VerifyPtr(ptr);
+        }
+        if (medium_.OwnsPoolOf(ptr)) {
+            return medium_.VerifyPtr(ptr);
+        }
+        return arena_.VerifyPtr(ptr);
+    }
+
+    /**
+     * @brief Frees all memory allocated with Lifetime::REQUEST
+     */
+    void ResetArena()
+    {
+        arena_.Free();
+    }
+
+    SmallAllocator &GetSmallAllocator()
+    {
+        return small_;
+    }
+
+    MediumAllocator &GetMediumAllocator()
+    {
+        return medium_;
+    }
+
+    // the arena gives Mark() and Rewind() for nested request scopes
+    ArenaAllocator &GetArena()
+    {
+        return arena_;
+    }
+
+private:
+    SmallAllocator small_;
+    MediumAllocator medium_;
+    ArenaAllocator arena_;
+};
+
+#endif  // MEMORY_MANAGEMENT_TIERED_ALLOCATOR_INCLUDE_TIERED_ALLOCATOR_H
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "memory_management/bump_pointer_allocator/include/bump_pointer_allocator.h"
+#include "memory_management/free_list_allocator/include/free_list_allocator.h"
+#include "memory_management/run_of_slots_allocator/include/run_of_slots_allocator.h"
+#include "memory_management/tiered_allocator/include/tiered_allocator.h"
+
+namespace {
+constexpr size_t SMALL_POOL_SIZE = 1024U;
+constexpr size_t MEDIUM_POOL_SIZE = 1U << 16U;
+constexpr size_t ARENA_SIZE = 4096U;
+using Allocator = TieredAllocator<RunOfSlotsAllocator<SMALL_POOL_SIZE, 8U, 16U, 32U>,
+                                  FreeListAllocator<MEDIUM_POOL_SIZE>, BumpPointerAllocator<ARENA_SIZE>>;
+}  // namespace
+
+TEST(TieredAllocatorTest, RoutingTest)
+{
+    Allocator allocator;
+
+    auto *small = allocator.Allocate<uint64_t>();
+    auto *array = allocator.Allocate<uint64_t>(16U);
+    auto *big = allocator.Allocate<std::array<uint64_t, 8U>>();  // there is no such size class
+    auto *request = allocator.Allocate<uint64_t>(1U, Lifetime::REQUEST);
+    ASSERT_TRUE(allocator.GetSmallAllocator().VerifyPtr(small));
+    ASSERT_TRUE(allocator.GetMediumAllocator().VerifyPtr(array));
+    ASSERT_TRUE(allocator.GetMediumAllocator().VerifyPtr(big));
+    ASSERT_TRUE(allocator.GetArena().VerifyPtr(request));
+    for (void *mem : std::array<void *, 4U> {small, array, big, request}) {
+        ASSERT_TRUE(allocator.VerifyPtr(mem));
+    }
+    size_t onStack = 0;
+    ASSERT_FALSE(allocator.VerifyPtr(&onStack));
+
+    allocator.Free(small);
+    allocator.Free(array);
+    allocator.Free(big);
+    allocator.Free(request);  // is freed with the arena
+    allocator.Free(nullptr);
+    ASSERT_FALSE(allocator.VerifyPtr(small));
+    ASSERT_FALSE(allocator.VerifyPtr(array));
+    ASSERT_FALSE(allocator.VerifyPtr(big));
+    ASSERT_TRUE(allocator.VerifyPtr(request));
+    allocator.ResetArena();
+    ASSERT_FALSE(allocator.VerifyPtr(request));
+}
+
+TEST(TieredAllocatorTest, SmallOverflowTest)
+{
+    Allocator allocator;
+
+    // small objects go to the medium allocator once their size class is full
+    std::vector<uint64_t *> mems;
+    for (size_t i = 0; i < 2U * SMALL_POOL_SIZE / sizeof(uint64_t); ++i) {
+        mems.push_back(allocator.Allocate<uint64_t>());
+        ASSERT_NE(mems.back(), nullptr);
+        *mems.back() = i;
+    }
+    ASSERT_TRUE(allocator.GetMediumAllocator().VerifyPtr(mems.back()));
+    for (size_t i = 0; i < mems.size(); ++i) {
+        ASSERT_EQ(*mems[i], i);
+        allocator.Free(mems[i]);
+    }
+    for (auto *mem : mems) {
+        ASSERT_FALSE(allocator.VerifyPtr(mem));
+    }
+}